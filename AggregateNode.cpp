@@ -0,0 +1,137 @@
+/**
+ * @file AggregateNode.cpp
+ * The implementation file for the AggregateNode class.
+ * @date October 2026
+ */
+
+#include "AggregateNode.h"
+#include <utility>      // for move
+
+// add one amount to the aggregate
+void Aggregate::add(double amount) {
+    if (count == 0 || amount < min) {
+        min = amount;
+    }
+    if (count == 0 || amount > max) {
+        max = amount;
+    }
+    count++;
+    sum += amount;
+}
+
+// fold another aggregate into this one
+void Aggregate::merge(const Aggregate& other) {
+    // an empty aggregate has no meaningful min/max to compare against
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0 || other.min < min) {
+        min = other.min;
+    }
+    if (count == 0 || other.max > max) {
+        max = other.max;
+    }
+    count += other.count;
+    sum += other.sum;
+}
+
+// the average amount
+double Aggregate::average() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    return sum / count;
+}
+
+// constructor for an empty group
+AggregateNode::AggregateNode(const string& key) {
+    this->key = key;
+    left = nullptr;         // points to nothing
+    right = nullptr;        // points to nothing
+}
+
+// getter for the key
+const string& AggregateNode::getKey() const {
+    return key;
+}
+
+// getter for this key's own aggregate
+const Aggregate& AggregateNode::getOwn() const {
+    return own;
+}
+
+// getter for the subtree aggregate
+const Aggregate& AggregateNode::getSubtree() const {
+    return subtree;
+}
+
+// record one more amount for this key
+void AggregateNode::addAmount(double amount) {
+    amounts.push_back(amount);
+    own.add(amount);
+}
+
+// remove one amount from this key
+bool AggregateNode::removeAmount(double amount) {
+    for (size_t i = 0; i < amounts.size(); i++) {
+        if (amounts[i] == amount) {
+            amounts[i] = amounts.back();
+            amounts.pop_back();
+            // min or max may have been the one removed, so start over
+            own = Aggregate();
+            for (size_t j = 0; j < amounts.size(); j++) {
+                own.add(amounts[j]);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// determine if an amount has been recorded for this key
+bool AggregateNode::hasAmount(double amount) const {
+    for (size_t i = 0; i < amounts.size(); i++) {
+        if (amounts[i] == amount) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// take over the key and amounts of another node
+void AggregateNode::takeContents(AggregateNode* other) {
+    key = std::move(other->key);
+    amounts = std::move(other->amounts);
+    own = other->own;
+}
+
+// recompute the subtree aggregate from this key and the children
+void AggregateNode::updateSubtree() {
+    subtree = own;
+    if (left != nullptr) {
+        subtree.merge(left->getSubtree());
+    }
+    if (right != nullptr) {
+        subtree.merge(right->getSubtree());
+    }
+}
+
+// getter for left pointer
+AggregateNode* AggregateNode::getLeft() const {
+    return left;
+}
+
+// getter for right pointer
+AggregateNode* AggregateNode::getRight() const {
+    return right;
+}
+
+// setter for left pointer
+void AggregateNode::setLeft(AggregateNode* next) {
+    left = next;
+}
+
+// setter for right pointer
+void AggregateNode::setRight(AggregateNode* next) {
+    right = next;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file AggregateNode.h
+ * A node for an AggregateTree:  one group key, the amounts recorded for it, and
+ * running aggregates for the key itself and for its whole subtree.
+ * @date October 2026
+ */
+
+#ifndef AGGREGATENODE_H
+#define AGGREGATENODE_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Count, sum, min and max of a set of amounts.
+ */
+struct Aggregate {
+    int count = 0;              // number of amounts
+    double sum = 0.0;           // total of the amounts
+    double min = 0.0;           // smallest amount (only meaningful if count > 0)
+    double max = 0.0;           // largest amount (only meaningful if count > 0)
+
+    /**
+     * Add one amount
+     * @param amount the amount to add
+     */
+    void add(double amount);
+
+    /**
+     * Add everything in another aggregate
+     * @param other the aggregate to fold in
+     */
+    void merge(const Aggregate& other);
+
+    /**
+     * The average amount
+     * @return sum / count, or 0 if there are no amounts
+     */
+    double average() const;
+};
+
+/**
+ * A class representing one group in an AggregateTree.
+ */
+class AggregateNode {
+private:
+    /** the group key (e.g. a zip code) */
+    string key;
+    /** every amount recorded for this key, so min/max can be recomputed after a removal */
+    vector<double> amounts;
+    /** the aggregate of this key's own amounts */
+    Aggregate own;
+    /** the aggregate of every amount in the subtree rooted here, including this key */
+    Aggregate subtree;
+    /** a link to the left child node */
+    AggregateNode* left;
+    /** a link to the right child node */
+    AggregateNode* right;
+
+public:
+    /**
+     * constructor for an empty group
+     * @param key the group key
+     */
+    explicit AggregateNode(const string& key);
+
+    /**
+     * Getter for the key
+     * @return the group key
+     */
+    const string& getKey() const;
+
+    /**
+     * Getter for this key's own aggregate
+     * @return the aggregate of this key's amounts
+     */
+    const Aggregate& getOwn() const;
+
+    /**
+     * Getter for the subtree aggregate
+     * @return the aggregate of every amount in this subtree
+     */
+    const Aggregate& getSubtree() const;
+
+    /**
+     * Record one more amount for this key.  Call updateSubtree afterwards.
+     * @param amount the amount to add
+     */
+    void addAmount(double amount);
+
+    /**
+     * Remove one amount from this key.  Call updateSubtree afterwards.
+     * @param amount the amount to remove
+     * @return true if the amount was found and removed
+     */
+    bool removeAmount(double amount);
+
+    /**
+     * Determine if an amount has been recorded for this key
+     * @param amount the amount to look for
+     * @return true if removeAmount would find it
+     */
+    bool hasAmount(double amount) const;
+
+    /**
+     * Take over the key and amounts of another node (used when a node is deleted and its
+     * in order predecessor moves into its place).  Call updateSubtree afterwards.
+     * @param other the node to take from
+     */
+    void takeContents(AggregateNode* other);
+
+    /**
+     * Recompute the subtree aggregate from this key and the children.  The children
+     * must already be up to date.
+     */
+    void updateSubtree();
+
+    /**
+     * Getter for the left child
+     * @return a pointer to the left node
+     */
+    AggregateNode* getLeft() const;
+
+    /**
+     * Getter for the right child
+     * @return a pointer to the right node
+     */
+    AggregateNode* getRight() const;
+
+    /**
+     * Setter for the left child
+     * @param next pointer to the left child
+     */
+    void setLeft(AggregateNode* next);
+
+    /**
+     * Setter for the right child
+     * @param next pointer to the right child
+     */
+    void setRight(AggregateNode* next);
+};
+#endif //AGGREGATENODE_H
@@ -0,0 +1,259 @@
+/**
+ * @file AggregateTree.cpp
+ * A Binary Search Tree of group keys in which every node also keeps the count, sum,
+ * min and max of all amounts in its subtree.
+ * @date October 2026
+ */
+
+#include "AggregateTree.h"
+#include <cstdio>
+using namespace std;
+
+// Default constructor, initialize empty tree
+AggregateTree::AggregateTree() {
+    root = nullptr;
+    numGroups = 0;
+}
+
+// Default destructor, free all memory used in the tree
+AggregateTree::~AggregateTree() {
+    postorderDelete(root);
+    root = nullptr;
+}
+
+// Determine if the tree is empty.
+bool AggregateTree::isEmpty() const {
+    return root == nullptr;
+}
+
+// Record an amount under a key, creating the key's group if needed.
+void AggregateTree::insertAmount(const string& key, double amount) {
+    vector<AggregateNode*> path;        // the nodes from root down to the key's parent
+    AggregateNode* node = findPath(key, path);
+
+    if (node == nullptr) {
+        // a new group -- hang it off the last node on the path, just like insertNode
+        node = new AggregateNode(key);
+        if (path.empty()) {
+            root = node;
+        } else if (key < path.back()->getKey()) {
+            path.back()->setLeft(node);
+        } else {
+            path.back()->setRight(node);
+        }
+        numGroups++;
+    }
+
+    node->addAmount(amount);
+    node->updateSubtree();
+    // every subtree above the key now holds one more amount
+    updatePath(path);
+}
+
+// Remove one recorded amount from a key.
+void AggregateTree::removeAmount(const string& key, double amount) throw(logic_error) {
+    vector<AggregateNode*> path;        // the nodes from root down to the key's parent
+    AggregateNode* node = findPath(key, path);
+
+    if (node == nullptr || !node->removeAmount(amount)) {
+        throw logic_error("Error -- cannot remove an amount that is not in the Aggregate Tree.");
+    }
+
+    if (node->getOwn().count == 0) {
+        // nothing left in this group -- take the node out of the tree
+        deleteGroup(node, path);
+    } else {
+        node->updateSubtree();
+    }
+    updatePath(path);
+}
+
+// Determine if an amount has been recorded under a key
+bool AggregateTree::containsAmount(const string& key, double amount) const {
+    vector<AggregateNode*> path;        // not needed, but findPath fills it
+    AggregateNode* node = findPath(key, path);
+
+    return node != nullptr && node->hasAmount(amount);
+}
+
+// Aggregate of a single key
+Aggregate AggregateTree::fetchGroup(const string& key) const {
+    vector<AggregateNode*> path;        // not needed, but findPath fills it
+    AggregateNode* node = findPath(key, path);
+
+    if (node == nullptr) {
+        return Aggregate();
+    }
+    return node->getOwn();
+}
+
+// Aggregate of every key from low to high, inclusive
+Aggregate AggregateTree::rangeAggregate(const string& low, const string& high) const {
+    Aggregate result;               // everything found in the range so far
+    AggregateNode* split = root;    // the highest node inside the range
+
+    // go down until the range no longer lies entirely on one side
+    while (split != nullptr && (split->getKey() < low || high < split->getKey())) {
+        if (split->getKey() < low) {
+            split = split->getRight();
+        } else {
+            split = split->getLeft();
+        }
+    }
+    if (split == nullptr) {
+        return result;
+    }
+    result.merge(split->getOwn());
+
+    // left boundary:  whenever we go left, this node and everything to its right is in the range
+    AggregateNode* node = split->getLeft();
+    while (node != nullptr) {
+        if (low <= node->getKey()) {
+            result.merge(node->getOwn());
+            if (node->getRight() != nullptr) {
+                result.merge(node->getRight()->getSubtree());
+            }
+            node = node->getLeft();
+        } else {
+            node = node->getRight();
+        }
+    }
+
+    // right boundary:  whenever we go right, this node and everything to its left is in the range
+    node = split->getRight();
+    while (node != nullptr) {
+        if (node->getKey() <= high) {
+            result.merge(node->getOwn());
+            if (node->getLeft() != nullptr) {
+                result.merge(node->getLeft()->getSubtree());
+            }
+            node = node->getRight();
+        } else {
+            node = node->getLeft();
+        }
+    }
+
+    return result;
+}
+
+// Aggregate of everything in the tree
+Aggregate AggregateTree::total() const {
+    if (root == nullptr) {
+        return Aggregate();
+    }
+    return root->getSubtree();
+}
+
+// Count the number of distinct keys
+int AggregateTree::countGroups() const {
+    return numGroups;
+}
+
+// Stream every group to visit in key order, with a running total
+void AggregateTree::groupBy(const GroupVisitor& visit) const {
+    vector<AggregateNode*> pending;     // nodes whose left side has been visited, but not the node itself
+    AggregateNode* thisNode = root;     // current node in the traversal
+    double runningTotal = 0.0;          // sum of every group visited so far
+
+    // in order traversal without recursion, so a deep tree can't run out of stack
+    while (thisNode != nullptr || !pending.empty()) {
+        while (thisNode != nullptr) {
+            pending.push_back(thisNode);
+            thisNode = thisNode->getLeft();
+        }
+        thisNode = pending.back();
+        pending.pop_back();
+
+        runningTotal += thisNode->getOwn().sum;
+        visit(thisNode->getKey(), thisNode->getOwn(), runningTotal);
+
+        thisNode = thisNode->getRight();
+    }
+}
+
+// Group by every key, one tab separated line per key
+string AggregateTree::groupByReport() const {
+    string outString = "";      // output string
+
+    groupBy([&outString](const string& key, const Aggregate& group, double runningTotal) {
+        char line[160];         // the numbers for one line
+        snprintf(line, sizeof(line), "\t%d\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n", group.count, group.sum,
+                 group.average(), group.min, group.max, runningTotal);
+        outString += key + line;
+    });
+
+    return outString;
+}
+
+// Collect the nodes on the way from root to key
+AggregateNode* AggregateTree::findPath(const string& key, vector<AggregateNode*>& path) const {
+    AggregateNode* node = root;     // current node in the search
+
+    path.clear();
+    while (node != nullptr && node->getKey() != key) {
+        path.push_back(node);
+        if (key < node->getKey()) {
+            node = node->getLeft();
+        } else {
+            node = node->getRight();
+        }
+    }
+    return node;
+}
+
+// Recompute the subtree aggregates of every node on the path, bottom up
+void AggregateTree::updatePath(const vector<AggregateNode*>& path) {
+    for (int i = (int) path.size() - 1; i >= 0; i--) {
+        path[i]->updateSubtree();
+    }
+}
+
+// Remove an empty group's node
+void AggregateTree::deleteGroup(AggregateNode* target, vector<AggregateNode*>& path) {
+    AggregateNode* parent = path.empty() ? nullptr : path.back();   // target's parent
+    AggregateNode* replacement = nullptr;                           // what takes target's place
+
+    if (target->getLeft() != nullptr && target->getRight() != nullptr) {
+        // two children:  as in BinarySearchTree, the LARGEST key on the left moves up
+        AggregateNode* tempPtr = target->getLeft();
+        AggregateNode* tempParent = target;
+        path.push_back(target);
+        while (tempPtr->getRight() != nullptr) {
+            tempParent = tempPtr;
+            path.push_back(tempPtr);
+            tempPtr = tempPtr->getRight();
+        }
+        target->takeContents(tempPtr);
+        // tempPtr has no right child; its left child (if any) takes its place
+        if (tempParent->getLeft() == tempPtr) {
+            tempParent->setLeft(tempPtr->getLeft());
+        } else {
+            tempParent->setRight(tempPtr->getLeft());
+        }
+        delete(tempPtr);
+        numGroups--;
+        return;
+    }
+
+    // zero or one child:  the child (or nothing) takes target's place
+    replacement = (target->getLeft() != nullptr) ? target->getLeft() : target->getRight();
+    if (parent == nullptr) {
+        root = replacement;
+    } else if (parent->getLeft() == target) {
+        parent->setLeft(replacement);
+    } else {
+        parent->setRight(replacement);
+    }
+    delete(target);
+    numGroups--;
+}
+
+// recursively delete nodes in a post order traversal
+void AggregateTree::postorderDelete(AggregateNode* thisNode) {
+    if (thisNode == nullptr) {
+        return;
+    }
+    postorderDelete(thisNode->getLeft());
+    postorderDelete(thisNode->getRight());
+    delete(thisNode);
+}
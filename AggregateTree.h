@@ -0,0 +1,143 @@
+/**
+ * @file AggregateTree.h
+ * A Binary Search Tree of group keys (e.g. zip codes) in which every node also keeps the
+ * count, sum, min and max of all amounts in its subtree.  Inserts and removals keep those
+ * aggregates up to date along their path, so the aggregate of any key range is answered
+ * by walking two paths instead of scanning every row.
+ * @date October 2026
+ */
+
+#ifndef AGGREGATETREE_H
+#define AGGREGATETREE_H
+
+#include "AggregateNode.h"
+#include <functional>
+#include <stdexcept>
+
+class AggregateTree {
+
+private:
+    AggregateNode* root;        // the beginning node of the tree
+    int numGroups;              // number of distinct keys in the tree
+
+public:
+    /**
+     * Called once per key, in key order, by groupBy
+     * (key, that key's aggregate, running total of the sums up to and including this key)
+     */
+    typedef function<void(const string&, const Aggregate&, double)> GroupVisitor;
+
+    /**
+     * Default constructor, initialize empty tree
+     */
+    AggregateTree();
+
+    /**
+     * Default destructor, free all memory used in the tree
+     */
+    ~AggregateTree();
+
+    // the tree owns its nodes, so copying it would free them twice
+    AggregateTree(const AggregateTree&) = delete;
+    AggregateTree& operator=(const AggregateTree&) = delete;
+
+    /**
+     * Determine if the tree is empty.
+     * @return true if the tree is empty, false otherwise
+     */
+    bool isEmpty() const;
+
+    /**
+     * Record an amount under a key, creating the key's group if needed.
+     * @param key the group key
+     * @param amount the amount to record
+     */
+    void insertAmount(const string& key, double amount);
+
+    /**
+     * Remove one recorded amount from a key.  The group is deleted once it is empty.
+     * @param key the group key
+     * @param amount the amount to remove (must match a recorded amount exactly)
+     * @throws logic_error if the key or the amount is not in the tree
+     */
+    void removeAmount(const string& key, double amount) throw(logic_error);
+
+    /**
+     * Determine if an amount has been recorded under a key
+     * @param key the group key
+     * @param amount the amount to look for
+     * @return true if removeAmount(key, amount) would succeed
+     */
+    bool containsAmount(const string& key, double amount) const;
+
+    /**
+     * Aggregate of a single key
+     * @param key the group key
+     * @return the aggregate of the key's amounts (count 0 if the key is not present)
+     */
+    Aggregate fetchGroup(const string& key) const;
+
+    /**
+     * Aggregate of every key from low to high, inclusive.  Only walks the two paths that
+     * bound the range, so it costs O(height), not O(number of keys).
+     * @param low the first key in the range
+     * @param high the last key in the range
+     * @return the aggregate of every amount in the range
+     */
+    Aggregate rangeAggregate(const string& low, const string& high) const;
+
+    /**
+     * Aggregate of everything in the tree.  O(1).
+     * @return the aggregate of every amount
+     */
+    Aggregate total() const;
+
+    /**
+     * Count the number of distinct keys
+     * @return the number of groups
+     */
+    int countGroups() const;
+
+    /**
+     * Stream every group to visit in key order, in one in order pass, with a running total.
+     * @param visit called once per key
+     */
+    void groupBy(const GroupVisitor& visit) const;
+
+    /**
+     * Group by every key, one tab separated line per key:
+     * key, count, sum, average, min, max, running total
+     * @return a string containing the report
+     */
+    string groupByReport() const;
+
+private:
+    /**
+     * Collect the nodes on the way from root to key (not including key's node itself, if present)
+     * @param key the key we are searching for
+     * @param path filled with the nodes passed, root first
+     * @return the node holding key, or nullptr
+     */
+    AggregateNode* findPath(const string& key, vector<AggregateNode*>& path) const;
+
+    /**
+     * Recompute the subtree aggregates of every node on the path, bottom up
+     * @param path the nodes from root down to the change
+     */
+    void updatePath(const vector<AggregateNode*>& path);
+
+    /**
+     * Remove an empty group's node, restructuring the tree by the Binary Search Tree rules
+     * @param target the node to remove
+     * @param path the nodes from root down to target's parent (extended as needed)
+     */
+    void deleteGroup(AggregateNode* target, vector<AggregateNode*>& path);
+
+    /**
+     * recursively delete nodes in a post order traversal
+     * @param thisNode the current node
+     */
+    void postorderDelete(AggregateNode* thisNode);
+};
+
+#endif //AGGREGATETREE_H
@@ -6,7 +6,10 @@
  */
 
 #include "BinarySearchTree.h"
+#include <cmath>
 #include <iostream>
+#include <thread>
+#include <unordered_map>
 #define DEBUG true      // used for debugging the destructor
 using namespace std;
 
@@ -14,6 +17,18 @@ using namespace std;
 BinarySearchTree::BinarySearchTree() {
     // set root equal to nullptr
     root = nullptr;
+    nodeCount = 0;
+    sizeSum = 0;
+    policy = NO_REBALANCE;
+    balanceFactor = 0.0;
+    maxNodeCount = 0;
+    rebuildCount = 0;
+    rebuiltNodes = 0;
+    nodeBlock = nullptr;
+    nodeBlockSize = 0;
+    membershipFilter = nullptr;
+    filterBitsPerKey = 0.0;
+    filterStaleKeys = 0;
 }
 
 // Default destrutor, free all memory used in the tree
@@ -26,9 +41,15 @@ BinarySearchTree::~BinarySearchTree() {
 
     // do a postorder tree traversal with delete
     postorderDelete(root);
+    // nodes written by compact live in one block, freed all at once
+    freeNodeBlock();
+    delete(membershipFilter);
+    membershipFilter = nullptr;
 
     // reset root to nullptr
     root = nullptr;
+    nodeCount = 0;
+    sizeSum = 0;
     //if (DEBUG) cout << "Tree is now empty." << endl;
 
     // we are done with this recursive function
@@ -90,18 +111,22 @@ void BinarySearchTree::insertNode(string newData) throw(logic_error) {
     TreeNode* newNode = nullptr;       // pointer to the new node
     TreeNode* searchNode = nullptr;    // used with findNode to find where this one goes
     TreeNode* parentNode = nullptr;    // used with findNode to find where this one goes
-
-    // create node and fill the new node with data
-    newNode = new TreeNode();
-    newNode->setData(newData);
+    vector<TreeNode*>& path = searchPath;  // the nodes from root down to the new node's parent
 
     // find where this node belongs in the tree by doing a search for it
-    findNode(newData, searchNode, parentNode);
+    findNode(newData, searchNode, path);
+    if (!path.empty()) {
+        parentNode = path.back();
+    }
 
     // searchNode should be null, otherwise we have a duplicate -- throw an error
     if (searchNode != nullptr) {
         throw logic_error("Error -- cannot insert a duplicate node in a Binary Search Tree.");
     } else { // the search was successful, and parentNode will be the parent for this node
+        // create node and fill the new node with data (only now, so a duplicate doesn't leak it)
+        newNode = new TreeNode();
+        newNode->setData(newData);
+
         // special case -- if the tree is empty, prentNode will be nullptr
         if (parentNode == nullptr) {
             // the new node *is* the root
@@ -115,6 +140,26 @@ void BinarySearchTree::insertNode(string newData) throw(logic_error) {
             // insert on right
             parentNode->setRight(newNode);
         }
+        nodeCount++;
+        sizeSum += newNode->getSize();
+
+        // keep the membership filter in step, rebuilding it bigger once it holds twice the
+        // keys it was sized for (by then its false positive rate has grown noticeably)
+        if (membershipFilter != nullptr) {
+            if (membershipFilter->getNumKeys() >= 2 * membershipFilter->getCapacity()) {
+                rebuildMembershipFilter();
+            } else {
+                membershipFilter->insert(newData);
+            }
+        }
+        if (nodeCount > maxNodeCount) {
+            maxNodeCount = nodeCount;
+        }
+
+        // every node above the new one grew by one, and may have grown taller
+        bool tooDeep = (policy == SCAPEGOAT_REBALANCE) && !path.empty() &&
+                       path.size() > log((double) maxNodeCount) / log(1.0 / balanceFactor);
+        reshapePath(path, tooDeep);
     }
 }
 
@@ -127,14 +172,18 @@ string BinarySearchTree::deleteNode(string key) {
     TreeNode* tempParent = nullptr;    // used if the deleted node has two children
     string returnValue = "";           // value to return
     bool rootFlag = false;             // true if we are deleting the root node
+    vector<TreeNode*>& path = searchPath;  // the nodes whose shape changes, from root down
 
-    // find the node to be deleted
-    findNode(key, searchNode, parentNode);
+    // find the node to be deleted; every node above it loses one node from its subtree
+    findNode(key, searchNode, path);
 
     // if node is not present, return NOT_FOUND_MESSAGE
     if (searchNode == nullptr) {
         return NOT_FOUND_MESSAGE;
     }
+    if (!path.empty()) {
+        parentNode = path.back();
+    }
 
     // store data so we can return it
     returnValue = searchNode->getData();
@@ -159,7 +208,8 @@ string BinarySearchTree::deleteNode(string key) {
             parentNode->setRight(nullptr);
         }
         // delete the node
-        delete(searchNode);
+        sizeSum -= searchNode->getSize();
+        releaseNode(searchNode);
         searchNode = nullptr;
     } else if (searchNode->getLeft() != nullptr && searchNode->getRight() == nullptr)
     {   /////// if there is only a left child of searchNode... /////
@@ -175,7 +225,8 @@ string BinarySearchTree::deleteNode(string key) {
             parentNode->setRight(searchNode->getLeft());
         }
         // now we can delete this node
-        delete(searchNode);
+        sizeSum -= searchNode->getSize();
+        releaseNode(searchNode);
         searchNode = nullptr;
 
     } else if (searchNode->getLeft() == nullptr && searchNode->getRight() != nullptr) {
@@ -192,7 +243,8 @@ string BinarySearchTree::deleteNode(string key) {
             parentNode->setRight(searchNode->getRight());
         }
         // now we can delete this node
-        delete(searchNode);
+        sizeSum -= searchNode->getSize();
+        releaseNode(searchNode);
         searchNode = nullptr;
     } else {
         // if the node has two children, find the deleted node’s LEFT descendant that has the LARGEST
@@ -202,28 +254,49 @@ string BinarySearchTree::deleteNode(string key) {
         // use tempPtr and tempParent to move to left child of searchNode
         tempPtr = searchNode->getLeft();
         tempParent = searchNode;
-        // now move tempPtr all the way to the right most leaf
+        path.push_back(searchNode);
+        // now move tempPtr all the way to the right most node
         while (tempPtr->getRight() != nullptr) {
             tempParent = tempPtr;
+            path.push_back(tempPtr);
             tempPtr = tempPtr->getRight();
         }
-        // now tempPtr points to a leaf, and tempParent is the leaf's parent
-        // we want the contents of this leaf to move to where searchNode is
-        searchNode->setData(tempPtr->getData());
-        // now, instead of deleting searchNode, we delete this leaf!
-        // need to determine if we are deleting a left or right child of tempParent
+        // now tempPtr points to the right most node, and tempParent is its parent
+        // we want the contents of this node to move to where searchNode is
+        searchNode->setData(tempPtr->takeData());
+        // now, instead of deleting searchNode, we delete this node!
+        // it has no right child, but it may have a left child, which takes its place
         if (tempParent->getLeft() == tempPtr) {
             // tempPtr is the left child
-            tempParent->setLeft(nullptr);
+            tempParent->setLeft(tempPtr->getLeft());
         } else {
             // tempPtr is the right child
-            tempParent->setRight(nullptr);
+            tempParent->setRight(tempPtr->getLeft());
         }
         // now delete it
-        delete(tempPtr);
+        sizeSum -= tempPtr->getSize();
+        releaseNode(tempPtr);
         tempPtr = nullptr;
     }
 
+    // one less node in the tree
+    nodeCount--;
+
+    // a Bloom filter can't forget a key, so rebuild it once enough deleted keys pile up
+    if (membershipFilter != nullptr) {
+        filterStaleKeys++;
+        if (filterStaleKeys > membershipFilter->getCapacity() / 4) {
+            rebuildMembershipFilter();
+        }
+    }
+
+    // fix up the shape of everything above the removed node
+    reshapePath(path, false);
+    // scapegoat trees rebuild everything once enough nodes have been deleted
+    if (policy == SCAPEGOAT_REBALANCE && nodeCount < balanceFactor * maxNodeCount) {
+        rebalance();
+    }
+
     // return the data
     return returnValue;
 }
@@ -234,6 +307,11 @@ string BinarySearchTree::fetchNode(string key) const {
     TreeNode* targetNode = nullptr;         // will point to the node we want
     TreeNode* parentNode = nullptr;         // will poitn to the parent node (we don't use this here)
 
+    // most misses stop here, after looking at one cache line of the filter
+    if (membershipFilter != nullptr && !membershipFilter->mayContain(key)) {
+        return NOT_FOUND_MESSAGE;
+    }
+
     // search for the node using findNode
     findNode(key, targetNode, parentNode);
 
@@ -245,6 +323,27 @@ string BinarySearchTree::fetchNode(string key) const {
     }
 }
 
+// Keep an approximate membership (Bloom) filter alongside the tree
+void BinarySearchTree::enableMembershipFilter(double bitsPerKey) throw(logic_error) {
+    if (bitsPerKey < 1.0) {
+        throw logic_error("Error -- a membership filter needs at least 1 bit per key.");
+    }
+    filterBitsPerKey = bitsPerKey;
+    rebuildMembershipFilter();
+}
+
+// Stop using the membership filter and free it
+void BinarySearchTree::disableMembershipFilter() {
+    delete(membershipFilter);
+    membershipFilter = nullptr;
+    filterStaleKeys = 0;
+}
+
+// Getter for the membership filter
+const BloomFilter* BinarySearchTree::getMembershipFilter() const {
+    return membershipFilter;
+}
+
 // Search for the old contents, remove it, then add the new contents.
 // Implemented as a delete followed by an insert.  TODO:  should throw
 // an exception if we can't find the old contents
@@ -293,14 +392,103 @@ string BinarySearchTree::postorderTraversal() const {
 
 // return the count of the number of nodes in the tree
 int BinarySearchTree::countNodes() const {
-    int numNodes = 0;      // number of nodes
+    // insertNode and deleteNode keep this up to date, so there is no need to traverse
+    return nodeCount;
+}
 
-    // conduct the traversal, using a private method (needed because we
-    // need to pass root, which is private
-    count(root, numNodes);
+// Report the height, average depth and balance of the tree
+TreeShape BinarySearchTree::shapeReport() const {
+    TreeShape shape;            // the report
 
-    // return the result
-    return numNodes;
+    shape.nodeCount = nodeCount;
+    shape.height = (root == nullptr) ? 0 : root->getHeight();
+    shape.optimalHeight = optimalHeight(nodeCount);
+    // a node is counted once in the size of each of its ancestors (and itself), i.e. once per level of depth
+    shape.averageDepth = (nodeCount == 0) ? 0.0 : (double) sizeSum / nodeCount;
+    shape.imbalance = (nodeCount == 0) ? 1.0 : (double) shape.height / shape.optimalHeight;
+    shape.rebuildCount = rebuildCount;
+    shape.rebuiltNodes = rebuiltNodes;
+
+    return shape;
+}
+
+// Choose when the tree rebuilds unbalanced subtrees
+void BinarySearchTree::setRebalancePolicy(RebalancePolicy newPolicy, double factor) throw(logic_error) {
+    if (newPolicy == SCAPEGOAT_REBALANCE && (factor <= 0.5 || factor >= 1.0)) {
+        throw logic_error("Error -- scapegoat alpha must be between 0.5 and 1.");
+    }
+    // close to 1, every subtree one level taller than optimal is rebuilt -- the root included,
+    // over and over -- and inserts cost O(n)
+    if (newPolicy == THRESHOLD_REBALANCE && factor < 1.2) {
+        throw logic_error("Error -- rebalance threshold must be at least 1.2.");
+    }
+    policy = newPolicy;
+    balanceFactor = factor;
+
+    // start out balanced, so the policy only has to keep it that way
+    if (policy != NO_REBALANCE) {
+        rebalance();
+    }
+}
+
+// Rebuild the whole tree into a perfectly balanced shape
+void BinarySearchTree::rebalance() {
+    if (root != nullptr) {
+        rebuildSubtree(root, nullptr);
+    }
+    maxNodeCount = nodeCount;
+}
+
+// Rewrite every node into one contiguous block, in the chosen order
+void BinarySearchTree::compact(NodeLayout layout) {
+    vector<TreeNode*> order;                    // the old nodes, in their new order
+    unordered_map<TreeNode*, int> newIndex;     // where each old node lands in the new block
+
+    if (root == nullptr) {
+        freeNodeBlock();
+        return;
+    }
+
+    order.reserve(nodeCount);
+    if (layout == BREADTH_FIRST_LAYOUT) {
+        // order doubles as the queue, so there is no recursion and no extra copy
+        order.push_back(root);
+        for (size_t i = 0; i < order.size(); i++) {
+            if (order[i]->getLeft() != nullptr) {
+                order.push_back(order[i]->getLeft());
+            }
+            if (order[i]->getRight() != nullptr) {
+                order.push_back(order[i]->getRight());
+            }
+        }
+    } else {
+        vanEmdeBoasOrder(root, root->getHeight(), order);
+    }
+    newIndex.reserve(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        newIndex[order[i]] = (int) i;
+    }
+
+    // both orders put every node before its children, so filling the new block from the
+    // bottom up finishes the children before their parents need their size and height;
+    // the strings are moved, not copied
+    TreeNode* newBlock = new TreeNode[order.size()];
+    for (int i = (int) order.size() - 1; i >= 0; i--) {
+        TreeNode* oldNode = order[i];
+        newBlock[i].setData(oldNode->takeData());
+        newBlock[i].setLeft(oldNode->getLeft() == nullptr ? nullptr : &newBlock[newIndex[oldNode->getLeft()]]);
+        newBlock[i].setRight(oldNode->getRight() == nullptr ? nullptr : &newBlock[newIndex[oldNode->getRight()]]);
+        newBlock[i].updateShape();
+    }
+
+    // the old nodes are empty now -- free them, then switch over to the new block
+    for (size_t i = 0; i < order.size(); i++) {
+        releaseNode(order[i]);
+    }
+    freeNodeBlock();
+    nodeBlock = newBlock;
+    nodeBlockSize = (int) order.size();
+    root = &newBlock[0];
 }
 
 // Perform an in order traversal, filling the_array as we go
@@ -314,6 +502,56 @@ void BinarySearchTree::inorderTraversalFillArray(string the_array[], int size) t
     inorderFillArray(root, the_array, index);
 }
 
+// Binary Search Tree sort:  move every node's contents into the_array, emptying the tree
+void BinarySearchTree::inorderTraversalDrainArray(string the_array[], int size) throw(logic_error) {
+    int index = 0;              // need a place to store the next index
+    // check before touching anything, so a mismatch leaves the tree intact
+    if (size != countNodes()) {
+        throw logic_error("Fatal error in Binary Search Tree sort.");
+    }
+
+    inorderDrainArray(root, the_array, index);
+
+    // every node has been freed
+    root = nullptr;
+    nodeCount = 0;
+    sizeSum = 0;
+    freeNodeBlock();
+    if (membershipFilter != nullptr) {
+        rebuildMembershipFilter();
+    }
+}
+
+// Binary Search Tree sort into a vector, emptying the tree
+void BinarySearchTree::inorderTraversalDrainVector(vector<string>& the_vector) {
+    // start from a clean vector of exactly the right size, so nothing is copied later
+    the_vector.clear();
+    the_vector.resize(countNodes());
+    if (the_vector.empty()) {
+        return;
+    }
+
+    inorderTraversalDrainArray(&the_vector[0], (int) the_vector.size());
+}
+
+// Parallel Binary Search Tree sort:  drain the two sides of the tree on separate threads
+void BinarySearchTree::parallelInorderTraversalDrainArray(string the_array[], int size, int numThreads) throw(logic_error) {
+    if (size != countNodes()) {
+        throw logic_error("Fatal error in Binary Search Tree sort.");
+    }
+
+    parallelInorderDrainArray(root, the_array, numThreads);
+
+    // every node has been freed
+    root = nullptr;
+    nodeCount = 0;
+    sizeSum = 0;
+    freeNodeBlock();
+    if (membershipFilter != nullptr) {
+        rebuildMembershipFilter();
+    }
+}
+
 // In order tree traversal, appending the contents to a string to be returned.
 // NOTE:  Need to have & so that we can change outString
 void BinarySearchTree::inorder(TreeNode* thisNode, string& outString) const {
@@ -399,7 +637,7 @@ void BinarySearchTree::postorderDelete(TreeNode* thisNode) {
     }
     // visit by deleting the node
     //if (DEBUG) cout << "Deleting [" + thisNode->getData() + "]..." << endl;
-    delete(thisNode);
+    releaseNode(thisNode);
     thisNode = nullptr;
 
     // we are done with this recursive function
@@ -449,4 +687,251 @@ void BinarySearchTree::inorderFillArray(TreeNode* thisNode, string the_array[],
     }
     // we are done with this recursive function
     return;
-}
\ No newline at end of file
+}
+
+// recursively move Node contents into the array, deleting nodes as we go
+void BinarySearchTree::inorderDrainArray(TreeNode* thisNode, string the_array[], int& next_index) {
+    if (thisNode == nullptr) {
+        return;
+    }
+    // move Left
+    inorderDrainArray(thisNode->getLeft(), the_array, next_index);
+    // visit by moving the string out -- no copy
+    the_array[next_index] = thisNode->takeData();
+    next_index++;
+    // move right
+    inorderDrainArray(thisNode->getRight(), the_array, next_index);
+    // both subtrees are gone, so this node can go too
+    releaseNode(thisNode);
+}
+
+// recursively move Node contents into the array, splitting the work across threads
+void BinarySearchTree::parallelInorderDrainArray(TreeNode* thisNode, string the_array[], int numThreads) {
+    int leftSize = 0;           // number of nodes to the left, which is also where thisNode goes
+
+    if (thisNode == nullptr) {
+        return;
+    }
+    // out of threads to hand out -- finish this subtree on the current one
+    if (numThreads <= 1) {
+        int index = 0;
+        inorderDrainArray(thisNode, the_array, index);
+        return;
+    }
+
+    // the left subtree fills the_array[0 .. leftSize - 1], so the two sides never overlap
+    TreeNode* leftNode = thisNode->getLeft();
+    // nothing on the left -- give every thread to the right side instead of starting an idle one
+    if (leftNode == nullptr) {
+        the_array[0] = thisNode->takeData();
+        parallelInorderDrainArray(thisNode->getRight(), the_array + 1, numThreads);
+        releaseNode(thisNode);
+        return;
+    }
+    leftSize = leftNode->getSize();
+    int leftThreads = numThreads / 2;
+    thread leftWorker([this, leftNode, the_array, leftThreads]() {
+        parallelInorderDrainArray(leftNode, the_array, leftThreads);
+    });
+
+    // visit, then drain the right side on this thread
+    the_array[leftSize] = thisNode->takeData();
+    parallelInorderDrainArray(thisNode->getRight(), the_array + leftSize + 1, numThreads - leftThreads);
+
+    leftWorker.join();
+    releaseNode(thisNode);
+}
+
+// free a node that is no longer in the tree
+void BinarySearchTree::releaseNode(TreeNode* thisNode) {
+    if (nodeBlock != nullptr && thisNode >= nodeBlock && thisNode < nodeBlock + nodeBlockSize) {
+        // part of the block -- just let go of the string now; the memory goes with the block
+        thisNode->takeData();
+        thisNode->setLeft(nullptr);
+        thisNode->setRight(nullptr);
+    } else {
+        delete(thisNode);
+    }
+}
+
+// recursively list a subtree's nodes in van Emde Boas order
+void BinarySearchTree::vanEmdeBoasOrder(TreeNode* top, int levels, vector<TreeNode*>& order) const {
+    if (top == nullptr || levels <= 0) {
+        return;
+    }
+    if (levels == 1) {
+        order.push_back(top);
+        return;
+    }
+
+    // lay out the top half of the levels as one small tree...
+    int topLevels = levels / 2;
+    vanEmdeBoasOrder(top, topLevels, order);
+
+    // ...then each subtree hanging below it, one after another
+    vector<TreeNode*> frontier;
+    collectLevel(top, topLevels, frontier);
+    for (size_t i = 0; i < frontier.size(); i++) {
+        vanEmdeBoasOrder(frontier[i], levels - topLevels, order);
+    }
+}
+
+// recursively collect the nodes exactly depth levels below thisNode, left to right
+void BinarySearchTree::collectLevel(TreeNode* thisNode, int depth, vector<TreeNode*>& frontier) const {
+    if (thisNode == nullptr) {
+        return;
+    }
+    if (depth == 0) {
+        frontier.push_back(thisNode);
+        return;
+    }
+    collectLevel(thisNode->getLeft(), depth - 1, frontier);
+    collectLevel(thisNode->getRight(), depth - 1, frontier);
+}
+
+// rebuild the membership filter from the keys in the tree
+void BinarySearchTree::rebuildMembershipFilter() {
+    vector<TreeNode*> pending;      // nodes still to visit
+    const int MIN_CAPACITY = 1024;  // so a small tree doesn't rebuild on every few inserts
+
+    // sized for the keys we have now; insertNode rebuilds it once the tree has doubled
+    int capacity = nodeCount > MIN_CAPACITY ? nodeCount : MIN_CAPACITY;
+    delete(membershipFilter);
+    membershipFilter = new BloomFilter(capacity, filterBitsPerKey);
+    filterStaleKeys = 0;
+
+    // visit every node (order doesn't matter), without recursion
+    if (root != nullptr) {
+        pending.push_back(root);
+    }
+    while (!pending.empty()) {
+        TreeNode* thisNode = pending.back();
+        pending.pop_back();
+        membershipFilter->insert(thisNode->getData());
+        if (thisNode->getLeft() != nullptr) {
+            pending.push_back(thisNode->getLeft());
+        }
+        if (thisNode->getRight() != nullptr) {
+            pending.push_back(thisNode->getRight());
+        }
+    }
+}
+
+// free the block written by compact
+void BinarySearchTree::freeNodeBlock() {
+    delete[] nodeBlock;
+    nodeBlock = nullptr;
+    nodeBlockSize = 0;
+}
+
+// search for a node, collecting the nodes on the way from root to key
+void BinarySearchTree::findNode(const string& key, TreeNode*& node, vector<TreeNode*>& path) const {
+    node = root;
+
+    // clear keeps the capacity, so a reused path stops allocating once it is deep enough
+    path.clear();
+    // same walk as findNode, remembering where we have been
+    while (node != nullptr && node->getData() != key) {
+        path.push_back(node);
+        if (key < node->getData()) {
+            node = node->getLeft();
+        } else {
+            node = node->getRight();
+        }
+    }
+}
+
+// recompute the size and height of one node, keeping sizeSum up to date
+void BinarySearchTree::reshape(TreeNode* thisNode) {
+    sizeSum -= thisNode->getSize();
+    thisNode->updateShape();
+    sizeSum += thisNode->getSize();
+}
+
+// recompute the shape of the path from the bottom up, rebuilding where the policy says to
+void BinarySearchTree::reshapePath(vector<TreeNode*>& path, bool lookForScapegoat) {
+    for (int i = (int) path.size() - 1; i >= 0; i--) {
+        TreeNode* thisNode = path[i];
+        TreeNode* parent = (i > 0) ? path[i - 1] : nullptr;
+
+        reshape(thisNode);
+
+        if (lookForScapegoat) {
+            // the scapegoat is the lowest ancestor where one side has more than alpha of the nodes
+            int leftSize = (thisNode->getLeft() == nullptr) ? 0 : thisNode->getLeft()->getSize();
+            int rightSize = (thisNode->getRight() == nullptr) ? 0 : thisNode->getRight()->getSize();
+            int biggerSide = (leftSize > rightSize) ? leftSize : rightSize;
+            if (biggerSide > balanceFactor * thisNode->getSize()) {
+                rebuildSubtree(thisNode, parent);
+                lookForScapegoat = false;
+            }
+        } else if (policy == THRESHOLD_REBALANCE &&
+                   thisNode->getHeight() > balanceFactor * optimalHeight(thisNode->getSize())) {
+            rebuildSubtree(thisNode, parent);
+        }
+    }
+}
+
+// rebuild a subtree into a perfectly balanced shape, reusing its nodes
+void BinarySearchTree::rebuildSubtree(TreeNode* top, TreeNode* parent) {
+    vector<TreeNode*> nodes;        // the nodes of the subtree, in order
+    vector<TreeNode*> pending;      // nodes whose left side has been visited, but not the node itself
+    TreeNode* thisNode = top;       // current node in the traversal
+
+    // in order traversal without recursion, since an unbalanced subtree can be very deep
+    nodes.reserve(top->getSize());
+    while (thisNode != nullptr || !pending.empty()) {
+        while (thisNode != nullptr) {
+            pending.push_back(thisNode);
+            thisNode = thisNode->getLeft();
+        }
+        thisNode = pending.back();
+        pending.pop_back();
+        nodes.push_back(thisNode);
+        // this node's old size no longer counts; buildBalanced adds the new one back
+        sizeSum -= thisNode->getSize();
+        thisNode = thisNode->getRight();
+    }
+
+    // relink the same nodes, middle first
+    TreeNode* newTop = buildBalanced(nodes, 0, (int) nodes.size());
+    if (parent == nullptr) {
+        root = newTop;
+    } else if (parent->getLeft() == top) {
+        parent->setLeft(newTop);
+    } else {
+        parent->setRight(newTop);
+    }
+
+    rebuildCount++;
+    rebuiltNodes += nodes.size();
+}
+
+// recursively link nodes[low .. high) into a balanced subtree
+TreeNode* BinarySearchTree::buildBalanced(vector<TreeNode*>& nodes, int low, int high) {
+    if (low >= high) {
+        return nullptr;
+    }
+    int middle = low + (high - low) / 2;
+    TreeNode* thisNode = nodes[middle];
+
+    thisNode->setLeft(buildBalanced(nodes, low, middle));
+    thisNode->setRight(buildBalanced(nodes, middle + 1, high));
+    // the children are finished, so this node's shape can be worked out
+    thisNode->updateShape();
+    sizeSum += thisNode->getSize();
+
+    return thisNode;
+}
+
+// the smallest possible height of a tree with numNodes nodes
+int BinarySearchTree::optimalHeight(int numNodes) {
+    int height = 0;             // number of levels so far
+    long long capacity = 0;     // most nodes that fit in that many levels
+
+    while (capacity < numNodes) {
+        height++;
+        capacity = capacity * 2 + 1;
+    }
+    return height;
+}
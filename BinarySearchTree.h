@@ -9,12 +9,60 @@
 #define BINARYSEARCHTREE_H
 
 #include "TreeNode.h"
+#include "BloomFilter.h"
 #include <stdexcept>
+#include <vector>
+
+/**
+ * A summary of the shape of a tree, as returned by BinarySearchTree::shapeReport.
+ * Depths and heights count levels, so the root is at depth 1.
+ */
+struct TreeShape {
+    int nodeCount;              // number of nodes in the tree
+    int height;                 // number of levels in the tree
+    int optimalHeight;          // the smallest possible height for nodeCount nodes
+    double averageDepth;        // average depth of a node, i.e. the average cost of a successful search
+    double imbalance;           // height / optimalHeight; 1.0 is perfectly balanced
+    long rebuildCount;          // number of subtree rebuilds done by the rebalance policy
+    long rebuiltNodes;          // total number of nodes moved by those rebuilds
+};
 
 class BinarySearchTree {
 
+public:
+    /**
+     * When (if ever) the tree rebuilds part of itself to stay balanced.
+     * NO_REBALANCE: never; the shape depends entirely on the insert order.
+     * SCAPEGOAT_REBALANCE: when an insert lands deeper than log base 1/alpha of the size,
+     *     rebuild the lowest ancestor where one side holds more than alpha of the nodes.
+     * THRESHOLD_REBALANCE: rebuild any subtree on the insert/delete path whose height is more
+     *     than factor times the best possible height for its size.
+     */
+    enum RebalancePolicy { NO_REBALANCE, SCAPEGOAT_REBALANCE, THRESHOLD_REBALANCE };
+
+    /**
+     * The order compact writes nodes into memory.
+     * BREADTH_FIRST_LAYOUT: level by level, so the top few levels share cache lines.
+     * VAN_EMDE_BOAS_LAYOUT: the top half of the levels first, then each bottom subtree in
+     *     turn, recursively, so every search path stays within few cache lines at any depth.
+     */
+    enum NodeLayout { BREADTH_FIRST_LAYOUT, VAN_EMDE_BOAS_LAYOUT };
+
 private:
     TreeNode *root;             // the beginning node of the tree
+    int nodeCount;              // number of nodes, kept up to date by insertNode and deleteNode
+    long long sizeSum;          // sum of every node's subtree size, which is also the sum of every node's depth
+    RebalancePolicy policy;     // when to rebuild unbalanced subtrees
+    double balanceFactor;       // alpha for SCAPEGOAT_REBALANCE, factor for THRESHOLD_REBALANCE
+    int maxNodeCount;           // SCAPEGOAT_REBALANCE: the most nodes since the last full rebuild
+    long rebuildCount;          // number of subtree rebuilds so far
+    long rebuiltNodes;          // number of nodes moved by those rebuilds
+    TreeNode* nodeBlock;        // contiguous block of nodes written by compact (or nullptr)
+    int nodeBlockSize;          // number of nodes in nodeBlock
+    BloomFilter* membershipFilter;  // optional filter that rejects most misses before a search (or nullptr)
+    double filterBitsPerKey;    // size of membershipFilter, in bits per key
+    int filterStaleKeys;        // deleted keys still set in membershipFilter
+    vector<TreeNode*> searchPath;   // scratch path for insertNode and deleteNode, kept to avoid an allocation per call
     const string NOT_FOUND_MESSAGE = "Did not locate node in tree."; // returned by findNode if not found
 
 public:
@@ -68,6 +116,27 @@ public:
      */
     string fetchNode(string key) const;
 
+    /**
+     * Keep an approximate membership (Bloom) filter alongside the tree, so fetchNode can
+     * reject most keys that aren't in the tree without searching it.  insertNode adds to the
+     * filter; deleted keys stay in it until it is rebuilt, which happens automatically once
+     * enough keys have been deleted or the tree outgrows it.
+     * @param bitsPerKey filter size in bits per key (about 10 gives 1% false positives)
+     * @throws logic_error if bitsPerKey is less than 1
+     */
+    void enableMembershipFilter(double bitsPerKey) throw(logic_error);
+
+    /**
+     * Stop using the membership filter and free it.
+     */
+    void disableMembershipFilter();
+
+    /**
+     * Getter for the membership filter, e.g. to measure its false positive rate
+     * @return the filter, or nullptr if it is not enabled
+     */
+    const BloomFilter* getMembershipFilter() const;
+
     /**
      * Search for the old contents, remove it, then add the new contents.
      * Implemented as a delete followed by an insert.  TODO:  should throw
@@ -96,11 +165,42 @@ public:
     string postorderTraversal() const;
 
     /**
-     * Count the number of nodes in the tree
+     * Count the number of nodes in the tree.  O(1), the count is kept as nodes come and go.
      * @return the total number of nodes
      */
     int countNodes() const;
 
+    /**
+     * Report the height, average depth and balance of the tree.  O(1), since every node
+     * keeps its subtree size and height up to date.
+     * @return the shape of the tree
+     */
+    TreeShape shapeReport() const;
+
+    /**
+     * Choose when the tree rebuilds unbalanced subtrees.  Switching a policy on also
+     * rebuilds the whole tree once, so it starts out balanced.
+     * @param newPolicy the policy to use
+     * @param factor alpha for SCAPEGOAT_REBALANCE (between 0.5 and 1, e.g. 0.7), or the allowed
+     *        height over the best possible for THRESHOLD_REBALANCE (at least 1.2, e.g. 2.0;
+     *        closer to 1 the tree rebuilds large subtrees almost every insert)
+     * @throws logic_error if factor is out of range for the policy
+     */
+    void setRebalancePolicy(RebalancePolicy newPolicy, double factor) throw(logic_error);
+
+    /**
+     * Rebuild the whole tree into a perfectly balanced shape, reusing the existing nodes.
+     */
+    void rebalance();
+
+    /**
+     * Rewrite every node into one contiguous block, so searches and traversals touch fewer
+     * cache lines and pages.  The tree's contents and shape don't change.  Nodes inserted
+     * afterwards are allocated one by one as usual, so call this again after heavy churn.
+     * @param layout the order to write the nodes in
+     */
+    void compact(NodeLayout layout = VAN_EMDE_BOAS_LAYOUT);
+
     /**
      * Perform an in order traversal, filling the_array as we go
      * @param the_array the array to place the Node contents into
@@ -108,6 +208,33 @@ public:
      */
     void inorderTraversalFillArray(string the_array[], int size) throw(logic_error) ;
 
+    /**
+     * Binary Search Tree sort:  move the contents of every node into the_array in sorted
+     * order, freeing the nodes as we go.  The strings are moved, not copied, and the tree
+     * is empty afterwards.
+     * @param the_array the array to place the Node contents into
+     * @param size the number of items in the array
+     * @throws logic_error if size does not match the number of nodes (the tree is not changed)
+     */
+    void inorderTraversalDrainArray(string the_array[], int size) throw(logic_error);
+
+    /**
+     * Binary Search Tree sort into a vector:  like inorderTraversalDrainArray, but the vector
+     * is resized to hold every node.
+     * @param the_vector the vector to place the Node contents into (any old contents are lost)
+     */
+    void inorderTraversalDrainVector(vector<string>& the_vector);
+
+    /**
+     * Parallel Binary Search Tree sort:  like inorderTraversalDrainArray, but the left and
+     * right sides of the tree are drained by separate threads, down to numThreads threads.
+     * @param the_array the array to place the Node contents into
+     * @param size the number of items in the array
+     * @param numThreads the most threads to use (1 gives the same result as inorderTraversalDrainArray)
+     * @throws logic_error if size does not match the number of nodes (the tree is not changed)
+     */
+    void parallelInorderTraversalDrainArray(string the_array[], int size, int numThreads) throw(logic_error);
+
 private:
 
     /**
@@ -150,6 +277,103 @@ private:
      */
     void inorderFillArray(TreeNode* thisNode, string the_array[], int& next_index);
 
+    /**
+     * recursively move Node contents into the array, deleting each node once its
+     * subtree has been drained
+     * @param thisNode the starting place
+     * @param the_array the array to move into
+     * @param next_index the next index to move into
+     */
+    void inorderDrainArray(TreeNode* thisNode, string the_array[], int& next_index);
+
+    /**
+     * recursively move Node contents into the array, draining the left subtree on
+     * another thread while this one drains the right
+     * @param thisNode the starting place
+     * @param the_array the array to move into, starting at index 0
+     * @param numThreads the most threads this subtree may use
+     */
+    void parallelInorderDrainArray(TreeNode* thisNode, string the_array[], int numThreads);
+
+    /**
+     * Free a node that is no longer in the tree.  Nodes allocated on their own are
+     * deleted; nodes in nodeBlock are emptied and left for the block to be freed.
+     * @param thisNode the node to free
+     */
+    void releaseNode(TreeNode* thisNode);
+
+    /**
+     * Rebuild the membership filter from the keys in the tree, sized for room to grow
+     */
+    void rebuildMembershipFilter();
+
+    /**
+     * Free nodeBlock.  Only call once no node in it is still in the tree.
+     */
+    void freeNodeBlock();
+
+    /**
+     * recursively list a subtree's nodes in van Emde Boas order, down to a number of levels
+     * @param top the root of the subtree
+     * @param levels how many levels of the subtree to list
+     * @param order the list to append to
+     */
+    void vanEmdeBoasOrder(TreeNode* top, int levels, vector<TreeNode*>& order) const;
+
+    /**
+     * recursively collect the nodes exactly depth levels below thisNode, left to right
+     * @param thisNode the current node
+     * @param depth how many more levels to go down
+     * @param frontier the list to append to
+     */
+    void collectLevel(TreeNode* thisNode, int depth, vector<TreeNode*>& frontier) const;
+
+    /**
+     * Search for a node like findNode, collecting every node on the way from root to key
+     * (not including key's node itself), so insertNode and deleteNode only search once.
+     * @param key the item we are searching for
+     * @param node a pointer to the node containing that item (or nullptr if not found)
+     * @param path filled with the nodes passed, root first; the last one is node's parent
+     */
+    void findNode(const string& key, TreeNode*& node, vector<TreeNode*>& path) const;
+
+    /**
+     * Recompute the size and height of one node, keeping sizeSum up to date
+     * @param thisNode the node to update (its children must already be up to date)
+     */
+    void reshape(TreeNode* thisNode);
+
+    /**
+     * After an insert or delete, recompute the shape of every node on the path from the
+     * bottom up, rebuilding subtrees that the rebalance policy says are too unbalanced.
+     * @param path the nodes from root down to the change
+     * @param lookForScapegoat true if an insert landed too deep and a scapegoat should be rebuilt
+     */
+    void reshapePath(vector<TreeNode*>& path, bool lookForScapegoat);
+
+    /**
+     * Rebuild a subtree into a perfectly balanced shape, reusing its nodes
+     * @param top the root of the subtree
+     * @param parent the parent of top (or nullptr if top is root)
+     */
+    void rebuildSubtree(TreeNode* top, TreeNode* parent);
+
+    /**
+     * recursively link nodes[low .. high) into a balanced subtree
+     * @param nodes the nodes of the subtree, in order
+     * @param low the first node to use
+     * @param high one past the last node to use
+     * @return the root of the new subtree
+     */
+    TreeNode* buildBalanced(vector<TreeNode*>& nodes, int low, int high);
+
+    /**
+     * The smallest possible height of a tree with numNodes nodes
+     * @param numNodes the number of nodes
+     * @return the number of levels in a perfectly balanced tree of that size
+     */
+    static int optimalHeight(int numNodes);
+
 };
 
 
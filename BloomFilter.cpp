@@ -0,0 +1,111 @@
+/**
+ * @file BloomFilter.cpp
+ * A blocked Bloom filter:  every key's bits live in one 64 byte block.
+ * @date October 2026
+ */
+
+#include "BloomFilter.h"
+#include <cmath>
+#include <functional>
+
+// Constructor, an empty filter sized for a number of keys
+BloomFilter::BloomFilter(int capacity, double bitsPerKey) {
+    this->capacity = capacity < 1 ? 1 : capacity;
+    numKeys = 0;
+
+    // round the total number of bits up to whole blocks
+    double totalBits = this->capacity * (bitsPerKey < 1.0 ? 1.0 : bitsPerKey);
+    numBlocks = (size_t) ceil(totalBits / (WORDS_PER_BLOCK * 64));
+    if (numBlocks < 1) {
+        numBlocks = 1;
+    }
+
+    // the best number of hashes for a plain Bloom filter is bits per key * ln 2; blocking
+    // makes the load per block uneven, so stay a little under that and within 1..16
+    numHashes = (int) (bitsPerKey * 0.69 + 0.5);
+    if (numHashes < 1) {
+        numHashes = 1;
+    } else if (numHashes > 16) {
+        numHashes = 16;
+    }
+
+    // over-allocate by one block's worth of words, then start at a 64 byte boundary,
+    // so probing a block never straddles two cache lines
+    storage.assign(numBlocks * WORDS_PER_BLOCK + WORDS_PER_BLOCK - 1, 0);
+    uintptr_t address = (uintptr_t) storage.data();
+    firstWord = ((64 - address % 64) % 64) / sizeof(uint64_t);
+}
+
+// Add a key
+void BloomFilter::insert(const string& key) {
+    uint64_t mask[WORDS_PER_BLOCK];
+    size_t block = probe(key, mask);
+
+    for (int i = 0; i < WORDS_PER_BLOCK; i++) {
+        storage[block + i] |= mask[i];
+    }
+    numKeys++;
+}
+
+// Check for a key
+bool BloomFilter::mayContain(const string& key) const {
+    uint64_t mask[WORDS_PER_BLOCK];
+    size_t block = probe(key, mask);
+    const uint64_t* words = &storage[block];
+
+    // test all 8 words without branching, so the compiler can do it as a few vector operations
+    uint64_t missing = 0;
+    for (int i = 0; i < WORDS_PER_BLOCK; i++) {
+        missing |= mask[i] & ~words[i];
+    }
+    return missing == 0;
+}
+
+// Forget every key, keeping the size
+void BloomFilter::clear() {
+    for (size_t i = 0; i < storage.size(); i++) {
+        storage[i] = 0;
+    }
+    numKeys = 0;
+}
+
+// getter for the capacity
+int BloomFilter::getCapacity() const {
+    return capacity;
+}
+
+// getter for the number of keys
+int BloomFilter::getNumKeys() const {
+    return numKeys;
+}
+
+// getter for the size of the filter
+size_t BloomFilter::getNumBits() const {
+    return numBlocks * WORDS_PER_BLOCK * 64;
+}
+
+// Work out which block a key goes in and which bits of that block it sets
+size_t BloomFilter::probe(const string& key, uint64_t mask[WORDS_PER_BLOCK]) const {
+    // std::hash can be weak in the low bits, so mix it (splitmix64 finalizer)
+    uint64_t hash = (uint64_t) std::hash<string>()(key);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    hash = hash ^ (hash >> 31);
+
+    // the low 32 bits pick the block (multiply and shift instead of a slow modulo)...
+    size_t block = (size_t) (((hash & 0xffffffffULL) * (uint64_t) numBlocks) >> 32);
+
+    // ...and repeatedly multiplying the whole hash by an odd constant gives the bit
+    // positions within it; the top 9 bits of the product pick one of the block's 512 bits
+    uint64_t state = hash;
+    for (int i = 0; i < WORDS_PER_BLOCK; i++) {
+        mask[i] = 0;
+    }
+    for (int i = 0; i < numHashes; i++) {
+        state *= 0x9e3779b97f4a7c15ULL;
+        int bit = (int) (state >> 55);
+        mask[bit / 64] |= (uint64_t) 1 << (bit % 64);
+    }
+
+    return firstWord + block * WORDS_PER_BLOCK;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file BloomFilter.h
+ * A blocked Bloom filter:  an approximate set of strings that can say "definitely not
+ * present" by looking at a single 64 byte block (one cache line) per key.  It can give
+ * false positives but never false negatives.  Keys can't be removed; rebuild it instead.
+ * @date October 2026
+ */
+
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+class BloomFilter {
+
+private:
+    static const int WORDS_PER_BLOCK = 8;   // 8 x 64 bits = 512 bits = one cache line
+
+    vector<uint64_t> storage;   // the bits, with room to start the first block on a cache line
+    size_t firstWord;           // index in storage where the first (aligned) block starts
+    size_t numBlocks;           // number of 512 bit blocks
+    int numHashes;              // bits set per key, all within the key's block
+    int capacity;               // number of keys the filter was sized for
+    int numKeys;                // number of keys added so far
+
+public:
+    /**
+     * Constructor, an empty filter sized for a number of keys
+     * @param capacity the number of keys expected (at least 1 is used)
+     * @param bitsPerKey bits of filter per expected key; more bits give fewer false positives
+     */
+    BloomFilter(int capacity, double bitsPerKey);
+
+    /**
+     * Add a key
+     * @param key the key to add
+     */
+    void insert(const string& key);
+
+    /**
+     * Check for a key
+     * @param key the key to look for
+     * @return false if the key was definitely never added, true if it probably was
+     */
+    bool mayContain(const string& key) const;
+
+    /**
+     * Forget every key, keeping the size
+     */
+    void clear();
+
+    /**
+     * Getter for the capacity
+     * @return the number of keys the filter was sized for
+     */
+    int getCapacity() const;
+
+    /**
+     * Getter for the number of keys
+     * @return the number of keys added since the filter was built or cleared
+     */
+    int getNumKeys() const;
+
+    /**
+     * Getter for the size of the filter
+     * @return the number of bits in the filter
+     */
+    size_t getNumBits() const;
+
+private:
+    /**
+     * Work out which block a key goes in and which bits of that block it sets
+     * @param key the key
+     * @param mask filled with the key's bits within the block, one word per entry
+     * @return the index of the first word of the key's block in storage
+     */
+    size_t probe(const string& key, uint64_t mask[WORDS_PER_BLOCK]) const;
+};
+
+#endif //BLOOMFILTER_H
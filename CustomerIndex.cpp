@@ -0,0 +1,114 @@
+/**
+ * @file CustomerIndex.cpp
+ * Revenue rollups over the customer CSV files, grouped by State, City and Zip.
+ * @date October 2026
+ */
+
+#include "CustomerIndex.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+using namespace std;
+
+// Read every row of a customer CSV file
+vector<CustomerRecord> CustomerIndex::readCustomerFile(const string& fileName) throw(logic_error) {
+    vector<CustomerRecord> records;     // the rows read so far
+    string line;                        // one line of the file
+    int lineNumber = 0;                 // for error messages
+
+    ifstream inFile(fileName);
+    if (!inFile) {
+        throw logic_error("Error -- could not open customer file " + fileName + ".");
+    }
+
+    while (getline(inFile, line)) {
+        lineNumber++;
+        // skip the header and any blank lines
+        if (lineNumber == 1 || trim(line).empty()) {
+            continue;
+        }
+
+        vector<string> fields;          // the comma separated fields of this line
+        string field;
+        istringstream lineStream(line);
+        while (getline(lineStream, field, ',')) {
+            fields.push_back(trim(field));
+        }
+        if (fields.size() != 6) {
+            throw logic_error("Error -- expected 6 fields on line " + to_string(lineNumber) + " of " + fileName + ".");
+        }
+
+        CustomerRecord record;
+        record.name = fields[0];
+        record.address = fields[1];
+        record.city = fields[2];
+        record.state = fields[3];
+        record.zip = fields[4];
+        char* end = nullptr;
+        record.transactionTotal = strtod(fields[5].c_str(), &end);
+        if (fields[5].empty() || *end != '\0') {
+            throw logic_error("Error -- bad TransactionTotal on line " + to_string(lineNumber) + " of " + fileName + ".");
+        }
+        records.push_back(record);
+    }
+
+    return records;
+}
+
+// Read a customer CSV file and add every row to the index
+int CustomerIndex::loadFile(const string& fileName) throw(logic_error) {
+    // read the whole file first, so a bad row leaves the index unchanged
+    vector<CustomerRecord> records = readCustomerFile(fileName);
+
+    for (size_t i = 0; i < records.size(); i++) {
+        addRecord(records[i]);
+    }
+    return (int) records.size();
+}
+
+// Add one row's TransactionTotal under its State, City and Zip
+void CustomerIndex::addRecord(const CustomerRecord& record) {
+    byState.insertAmount(record.state, record.transactionTotal);
+    byCity.insertAmount(record.city, record.transactionTotal);
+    byZip.insertAmount(record.zip, record.transactionTotal);
+}
+
+// Remove one row's TransactionTotal from its State, City and Zip
+void CustomerIndex::removeRecord(const CustomerRecord& record) throw(logic_error) {
+    // check all three first, so a row that doesn't match one of them doesn't leave the
+    // trees out of step
+    if (!byZip.containsAmount(record.zip, record.transactionTotal) ||
+        !byCity.containsAmount(record.city, record.transactionTotal) ||
+        !byState.containsAmount(record.state, record.transactionTotal)) {
+        throw logic_error("Error -- cannot remove a customer record that is not in the index.");
+    }
+    byZip.removeAmount(record.zip, record.transactionTotal);
+    byCity.removeAmount(record.city, record.transactionTotal);
+    byState.removeAmount(record.state, record.transactionTotal);
+}
+
+// getter for the State rollup
+const AggregateTree& CustomerIndex::getByState() const {
+    return byState;
+}
+
+// getter for the City rollup
+const AggregateTree& CustomerIndex::getByCity() const {
+    return byCity;
+}
+
+// getter for the Zip rollup
+const AggregateTree& CustomerIndex::getByZip() const {
+    return byZip;
+}
+
+// remove spaces and tabs (and a stray carriage return) from both ends of a field
+string CustomerIndex::trim(const string& field) {
+    const string WHITESPACE = " \t\r\n";
+    size_t first = field.find_first_not_of(WHITESPACE);
+    if (first == string::npos) {
+        return "";
+    }
+    size_t last = field.find_last_not_of(WHITESPACE);
+    return field.substr(first, last - first + 1);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file CustomerIndex.h
+ * Revenue rollups over the customer CSV files:  every row's TransactionTotal is recorded
+ * in three AggregateTrees, grouped by State, City and Zip.
+ * @date October 2026
+ */
+
+#ifndef CUSTOMERINDEX_H
+#define CUSTOMERINDEX_H
+
+#include "AggregateTree.h"
+#include <stdexcept>
+
+/**
+ * One row of a customer file (Name,Address,City,State,Zip,TransactionTotal)
+ */
+struct CustomerRecord {
+    string name;                // customer name, surrounding spaces removed
+    string address;             // street address
+    string city;                // city
+    string state;               // two letter state
+    string zip;                 // zip code, kept as text so it sorts digit by digit
+    double transactionTotal;    // amount spent
+};
+
+class CustomerIndex {
+
+private:
+    AggregateTree byState;      // TransactionTotal grouped by State
+    AggregateTree byCity;       // TransactionTotal grouped by City
+    AggregateTree byZip;        // TransactionTotal grouped by Zip
+
+public:
+    /**
+     * Read every row of a customer CSV file (the first line is the header).
+     * @param fileName the file to read
+     * @return the rows, in file order
+     * @throws logic_error if the file can't be opened or a row is malformed
+     */
+    static vector<CustomerRecord> readCustomerFile(const string& fileName) throw(logic_error);
+
+    /**
+     * Read a customer CSV file and add every row to the index.
+     * @param fileName the file to read
+     * @return the number of rows added
+     * @throws logic_error if the file can't be opened or a row is malformed
+     */
+    int loadFile(const string& fileName) throw(logic_error);
+
+    /**
+     * Add one row's TransactionTotal under its State, City and Zip
+     * @param record the row to add
+     */
+    void addRecord(const CustomerRecord& record);
+
+    /**
+     * Remove one row's TransactionTotal from its State, City and Zip
+     * @param record the row to remove (must have been added)
+     * @throws logic_error if the row is not in the index (none of the trees are changed)
+     */
+    void removeRecord(const CustomerRecord& record) throw(logic_error);
+
+    /**
+     * Getter for the State rollup
+     * @return the tree grouped by State
+     */
+    const AggregateTree& getByState() const;
+
+    /**
+     * Getter for the City rollup
+     * @return the tree grouped by City
+     */
+    const AggregateTree& getByCity() const;
+
+    /**
+     * Getter for the Zip rollup
+     * @return the tree grouped by Zip
+     */
+    const AggregateTree& getByZip() const;
+
+private:
+    /**
+     * Remove spaces and tabs (and a stray carriage return) from both ends of a field
+     * @param field the text to trim
+     * @return the trimmed text
+     */
+    static string trim(const string& field);
+};
+
+#endif //CUSTOMERINDEX_H
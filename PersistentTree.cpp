@@ -0,0 +1,252 @@
+/**
+ * @file PersistentTree.cpp
+ * A persistent (copy on write) Binary Search Tree.  insertNode and deleteNode copy only the
+ * nodes on the path to the change and then publish a new root, so readers can take a
+ * snapshot in O(1) and traverse it while writers keep going.  The nodes are kept in treap
+ * order, with priorities hashed from the keys, so the expected height -- and so the number
+ * of nodes a write copies, and the recursion depth -- is O(log n) whatever the insertion
+ * order (keys chosen to collide in the hash can still unbalance it).
+ * @date October 2026
+ */
+
+#include "PersistentTree.h"
+using namespace std;
+
+const string PersistentTree::Snapshot::NOT_FOUND_MESSAGE = "Did not locate node in tree.";
+
+// Constructor, view the version of the tree starting at root
+PersistentTree::Snapshot::Snapshot(PersistentNodePtr root) : root(root) {
+}
+
+// Determine if this version of the tree is empty.
+bool PersistentTree::Snapshot::isEmpty() const {
+    return root == nullptr;
+}
+
+// Search for and return the contents of a node, or NOT_FOUND_MESSAGE.
+string PersistentTree::Snapshot::fetchNode(string key) const {
+    // plain pointers are fine here, since root keeps every node of this version alive
+    const PersistentTreeNode* node = root.get();
+
+    while (node != nullptr) {
+        if (node->getData() == key) {
+            return node->getData();
+        } else if (key < node->getData()) {
+            node = node->getLeft().get();
+        } else {
+            node = node->getRight().get();
+        }
+    }
+    return NOT_FOUND_MESSAGE;
+}
+
+// Conduct an inorder traversal, starting from root
+string PersistentTree::Snapshot::inorderTraversal() const {
+    string outString = "";      // output string
+
+    inorder(root.get(), outString);
+
+    return outString;
+}
+
+// return the count of the number of nodes in this version of the tree
+int PersistentTree::Snapshot::countNodes() const {
+    int numNodes = 0;      // number of nodes
+
+    count(root.get(), numNodes);
+
+    return numNodes;
+}
+
+// Perform an in order traversal, filling the_array as we go
+void PersistentTree::Snapshot::inorderTraversalFillArray(string the_array[], int size) const throw(logic_error) {
+    int index = 0;              // need a place to store the next index
+    // a snapshot never changes, so the count can't go stale before we fill
+    if (size != countNodes()) {
+        throw logic_error("Fatal error in Binary Search Tree sort.");
+    }
+
+    inorderFillArray(root.get(), the_array, index);
+}
+
+// In order tree traversal, appending the contents to a string to be returned.
+void PersistentTree::Snapshot::inorder(const PersistentTreeNode* thisNode, string& outString) const {
+    if (thisNode == nullptr) {
+        return;
+    }
+    inorder(thisNode->getLeft().get(), outString);
+    outString += thisNode->getData() + "\t";
+    inorder(thisNode->getRight().get(), outString);
+}
+
+// recursively count the number of nodes
+void PersistentTree::Snapshot::count(const PersistentTreeNode* thisNode, int& numNodes) const {
+    if (thisNode == nullptr) {
+        return;
+    }
+    count(thisNode->getLeft().get(), numNodes);
+    count(thisNode->getRight().get(), numNodes);
+    numNodes++;
+}
+
+// recursively insert Node contents into the array
+void PersistentTree::Snapshot::inorderFillArray(const PersistentTreeNode* thisNode, string the_array[],
+                                                int& next_index) const {
+    if (thisNode == nullptr) {
+        return;
+    }
+    inorderFillArray(thisNode->getLeft().get(), the_array, next_index);
+    the_array[next_index] = thisNode->getData();
+    next_index++;
+    inorderFillArray(thisNode->getRight().get(), the_array, next_index);
+}
+
+// Default constructor, initialize empty tree
+PersistentTree::PersistentTree() {
+    root = nullptr;
+}
+
+// Take a snapshot of the newest version of the tree.
+PersistentTree::Snapshot PersistentTree::snapshot() const {
+    // the atomic load pairs with the atomic store in the writers, so we always get a whole version
+    return Snapshot(atomic_load(&root));
+}
+
+// Determine if the tree is empty.
+bool PersistentTree::isEmpty() const {
+    return snapshot().isEmpty();
+}
+
+// Insert a new item, copying the path from the root to its place and publishing a new root.
+void PersistentTree::insertNode(string newData) throw(logic_error) {
+    lock_guard<mutex> guard(writeLock);
+
+    // build the new version off to the side; if newData is a duplicate, nothing is published
+    PersistentNodePtr newRoot = insertCopy(atomic_load(&root), newData, PersistentTreeNode::priorityOf(newData));
+    atomic_store(&root, newRoot);
+}
+
+// Remove and return the contents of a node, or NOT_FOUND_MESSAGE.
+string PersistentTree::deleteNode(string key) {
+    bool found = false;         // set by deleteCopy if key is in the tree
+
+    lock_guard<mutex> guard(writeLock);
+
+    PersistentNodePtr newRoot = deleteCopy(atomic_load(&root), key, found);
+    if (!found) {
+        return NOT_FOUND_MESSAGE;
+    }
+    // the old version is freed once the last snapshot holding it is gone
+    atomic_store(&root, newRoot);
+
+    return key;
+}
+
+// Search the newest version for a node and return its contents.
+string PersistentTree::fetchNode(string key) const {
+    return snapshot().fetchNode(key);
+}
+
+// Search for the old contents, remove it, then add the new contents.
+void PersistentTree::updateNode(string oldContents, string newContents) {
+    deleteNode(oldContents);
+    insertNode(newContents);
+}
+
+// Conduct an inorder traversal of the newest version, without blocking writers
+string PersistentTree::inorderTraversal() const {
+    return snapshot().inorderTraversal();
+}
+
+// Count the number of nodes in the newest version
+int PersistentTree::countNodes() const {
+    return snapshot().countNodes();
+}
+
+// Build a copy of the subtree at thisNode with newData added.
+PersistentNodePtr PersistentTree::insertCopy(const PersistentNodePtr& thisNode, const string& newData,
+                                             size_t priority) const throw(logic_error) {
+    // reached the spot where the new item belongs
+    if (thisNode == nullptr) {
+        return make_shared<PersistentTreeNode>(newData, priority, nullptr, nullptr);
+    }
+
+    if (newData == thisNode->getData()) {
+        throw logic_error("Error -- cannot insert a duplicate node in a Binary Search Tree.");
+    } else if (newData < thisNode->getData()) {
+        PersistentNodePtr newLeft = insertCopy(thisNode->getLeft(), newData, priority);
+        if (newLeft->getPriority() > thisNode->getPriority()) {
+            // rotate right:  the new left child moves up, and a copy of this node becomes its right child
+            return make_shared<PersistentTreeNode>(newLeft->getData(), newLeft->getPriority(), newLeft->getLeft(),
+                                                   make_shared<PersistentTreeNode>(thisNode->getData(),
+                                                                                   thisNode->getPriority(),
+                                                                                   newLeft->getRight(),
+                                                                                   thisNode->getRight()));
+        }
+        // copy this node with a new left side; the right side is shared with the old version
+        return make_shared<PersistentTreeNode>(thisNode->getData(), thisNode->getPriority(), newLeft,
+                                               thisNode->getRight());
+    } else {
+        PersistentNodePtr newRight = insertCopy(thisNode->getRight(), newData, priority);
+        if (newRight->getPriority() > thisNode->getPriority()) {
+            // rotate left:  the new right child moves up, and a copy of this node becomes its left child
+            return make_shared<PersistentTreeNode>(newRight->getData(), newRight->getPriority(),
+                                                   make_shared<PersistentTreeNode>(thisNode->getData(),
+                                                                                   thisNode->getPriority(),
+                                                                                   thisNode->getLeft(),
+                                                                                   newRight->getLeft()),
+                                                   newRight->getRight());
+        }
+        // copy this node with a new right side; the left side is shared with the old version
+        return make_shared<PersistentTreeNode>(thisNode->getData(), thisNode->getPriority(), thisNode->getLeft(),
+                                               newRight);
+    }
+}
+
+// Build a copy of the subtree at thisNode with key removed.
+PersistentNodePtr PersistentTree::deleteCopy(const PersistentNodePtr& thisNode, const string& key,
+                                             bool& found) const {
+    // not here -- nothing to copy
+    if (thisNode == nullptr) {
+        return thisNode;
+    }
+
+    if (key < thisNode->getData()) {
+        PersistentNodePtr newLeft = deleteCopy(thisNode->getLeft(), key, found);
+        if (!found) {
+            return thisNode;
+        }
+        return make_shared<PersistentTreeNode>(thisNode->getData(), thisNode->getPriority(), newLeft,
+                                               thisNode->getRight());
+    } else if (thisNode->getData() < key) {
+        PersistentNodePtr newRight = deleteCopy(thisNode->getRight(), key, found);
+        if (!found) {
+            return thisNode;
+        }
+        return make_shared<PersistentTreeNode>(thisNode->getData(), thisNode->getPriority(), thisNode->getLeft(),
+                                               newRight);
+    }
+
+    // this is the node to remove:  its two sides are joined in its place
+    found = true;
+    return mergeCopy(thisNode->getLeft(), thisNode->getRight());
+}
+
+// Join two subtrees, where every item in left is smaller than every item in right
+PersistentNodePtr PersistentTree::mergeCopy(const PersistentNodePtr& left, const PersistentNodePtr& right) const {
+    // one side empty -- the other side is shared as is
+    if (left == nullptr) {
+        return right;
+    } else if (right == nullptr) {
+        return left;
+    }
+
+    // the root with the higher priority stays on top, and the other side merges into it
+    if (left->getPriority() >= right->getPriority()) {
+        return make_shared<PersistentTreeNode>(left->getData(), left->getPriority(), left->getLeft(),
+                                               mergeCopy(left->getRight(), right));
+    } else {
+        return make_shared<PersistentTreeNode>(right->getData(), right->getPriority(),
+                                               mergeCopy(left, right->getLeft()), right->getRight());
+    }
+}
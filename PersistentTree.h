@@ -0,0 +1,184 @@
+/**
+ * @file PersistentTree.h
+ * A persistent (copy on write) Binary Search Tree.  insertNode and deleteNode copy only the
+ * nodes on the path to the change and then publish a new root, so readers can take a
+ * snapshot in O(1) and traverse it while writers keep going.  The nodes are kept in treap
+ * order, with priorities hashed from the keys, so the expected height -- and so the number
+ * of nodes a write copies, and the recursion depth -- is O(log n) whatever the insertion
+ * order (keys chosen to collide in the hash can still unbalance it).
+ * @date October 2026
+ */
+
+#ifndef PERSISTENTTREE_H
+#define PERSISTENTTREE_H
+
+#include "PersistentTreeNode.h"
+#include <mutex>
+#include <stdexcept>
+
+class PersistentTree {
+
+public:
+    /**
+     * A read-only view of the tree as it was when the snapshot was taken.  A snapshot keeps
+     * its version of the tree alive; old versions are freed when their last snapshot goes away.
+     */
+    class Snapshot {
+    private:
+        PersistentNodePtr root;     // the root of this version of the tree
+        static const string NOT_FOUND_MESSAGE;  // returned by fetchNode if not found
+
+    public:
+        /**
+         * Constructor, view the version of the tree starting at root
+         * @param root the root of the version (or nullptr for an empty tree)
+         */
+        explicit Snapshot(PersistentNodePtr root);
+
+        /**
+         * Determine if this version of the tree is empty.
+         * @return true if the tree is empty, false otherwise
+         */
+        bool isEmpty() const;
+
+        /**
+         * Search for and return the contents of a node.
+         * @param key the item to search for
+         * @return the contents of the node, or NOT_FOUND_MESSAGE
+         */
+        string fetchNode(string key) const;
+
+        /**
+         * Conduct an inorder traversal, starting from root
+         * @return a string containing the contents of the nodes
+         */
+        string inorderTraversal() const;
+
+        /**
+         * Count the number of nodes in this version of the tree
+         * @return the total number of nodes
+         */
+        int countNodes() const;
+
+        /**
+         * Perform an in order traversal, filling the_array as we go
+         * @param the_array the array to place the Node contents into
+         * @param size the number of items in the array
+         * @throws logic_error if size does not match the number of nodes
+         */
+        void inorderTraversalFillArray(string the_array[], int size) const throw(logic_error);
+
+    private:
+        /**
+         * In order tree traversal, appending the contents to a string to be returned.
+         */
+        void inorder(const PersistentTreeNode* thisNode, string& outString) const;
+
+        /**
+         * recursively count the number of nodes in the tree
+         */
+        void count(const PersistentTreeNode* thisNode, int& numNodes) const;
+
+        /**
+         * recursively insert Node contents into the array
+         */
+        void inorderFillArray(const PersistentTreeNode* thisNode, string the_array[], int& next_index) const;
+    };
+
+private:
+    PersistentNodePtr root;     // the newest version; only read and written with atomic_load/atomic_store
+    mutex writeLock;            // writers take turns building new versions; readers never take it
+    const string NOT_FOUND_MESSAGE = "Did not locate node in tree."; // returned by deleteNode if not found
+
+public:
+    /**
+     * Default constructor, initialize empty tree
+     */
+    PersistentTree();
+
+    /**
+     * Take a snapshot of the newest version of the tree.  O(1), and never waits for writers.
+     * @return a read-only view of the tree
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * Determine if the tree is empty.
+     * @return true if the tree is empty, false otherwise
+     */
+    bool isEmpty() const;
+
+    /**
+     * Insert a new item, copying the path from the root to its place and publishing a new root.
+     * @param newData the information to insert into the node
+     * @throws a logic_error if a duplicate node is inserted
+     */
+    void insertNode(string newData) throw(logic_error);
+
+    /**
+     * Remove and return the contents of a node, copying the path to it and publishing a new root.
+     * @param key the identifying information for the node to delete
+     * @return the contents of a node, or NOT_FOUND_MESSAGE
+     */
+    string deleteNode(string key);
+
+    /**
+     * Search the newest version for a node and return its contents.
+     * @param key the item to search for
+     * @return the contents of the node, or NOT_FOUND_MESSAGE
+     */
+    string fetchNode(string key) const;
+
+    /**
+     * Search for the old contents, remove it, then add the new contents.  Readers see the
+     * delete and the insert as two separate versions.
+     * @param oldContents the item to remove
+     * @param newContents the item to add
+     */
+    void updateNode(string oldContents, string newContents);
+
+    /**
+     * Conduct an inorder traversal of the newest version, without blocking writers
+     * @return a string containing the contents of the nodes
+     */
+    string inorderTraversal() const;
+
+    /**
+     * Count the number of nodes in the newest version
+     * @return the total number of nodes
+     */
+    int countNodes() const;
+
+private:
+    /**
+     * Build a copy of the subtree at thisNode with newData added, rotating the new node up
+     * until its parent's priority is no lower than its own.
+     * @param thisNode the subtree to copy (not changed)
+     * @param newData the information to insert
+     * @param priority the treap priority of newData
+     * @return the root of the new subtree
+     * @throws a logic_error if newData is already in the subtree
+     */
+    PersistentNodePtr insertCopy(const PersistentNodePtr& thisNode, const string& newData,
+                                 size_t priority) const throw(logic_error);
+
+    /**
+     * Build a copy of the subtree at thisNode with key removed.
+     * @param thisNode the subtree to copy (not changed)
+     * @param key the item to remove
+     * @param found set to true if key was in the subtree
+     * @return the root of the new subtree (thisNode itself if key was not found)
+     */
+    PersistentNodePtr deleteCopy(const PersistentNodePtr& thisNode, const string& key, bool& found) const;
+
+    /**
+     * Join two subtrees, where every item in left is smaller than every item in right, copying
+     * only the nodes down the right edge of left and the left edge of right.
+     * @param left the subtree of smaller items (not changed)
+     * @param right the subtree of larger items (not changed)
+     * @return the root of the joined subtree
+     */
+    PersistentNodePtr mergeCopy(const PersistentNodePtr& left, const PersistentNodePtr& right) const;
+};
+
+#endif //PERSISTENTTREE_H
@@ -0,0 +1,45 @@
+/**
+ * @file PersistentTreeNode.cpp
+ * The implementation file for the PersistentTreeNode class.
+ * @date October 2026
+ */
+
+#include "PersistentTreeNode.h"
+#include <cstdint>
+#include <functional>
+
+// constructor
+PersistentTreeNode::PersistentTreeNode(const string& data, size_t priority, PersistentNodePtr left,
+                                       PersistentNodePtr right)
+        : data(data), priority(priority), left(left), right(right) {
+}
+
+// treap priority for a piece of data
+size_t PersistentTreeNode::priorityOf(const string& data) {
+    // std::hash may be close to the identity for similar keys, so finish it with the
+    // splitmix64 mixer to spread every input bit over the whole value
+    uint64_t mixed = hash<string>()(data);
+    mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+    return (size_t) (mixed ^ (mixed >> 31));
+}
+
+// getter for data
+const string& PersistentTreeNode::getData() const {
+    return data;
+}
+
+// getter for priority
+size_t PersistentTreeNode::getPriority() const {
+    return priority;
+}
+
+// getter for left link
+const PersistentNodePtr& PersistentTreeNode::getLeft() const {
+    return left;
+}
+
+// getter for right link
+const PersistentNodePtr& PersistentTreeNode::getRight() const {
+    return right;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file PersistentTreeNode.h
+ * An immutable node for a persistent (path copying) binary tree.  Once built, a node never
+ * changes, so any number of tree versions can share it safely.  Each node also carries a
+ * treap priority, derived from its data, which keeps the tree balanced.
+ * @date October 2026
+ */
+
+#ifndef PERSISTENTTREENODE_H
+#define PERSISTENTTREENODE_H
+
+#include <memory>
+#include <string>
+using namespace std;
+
+class PersistentTreeNode;
+
+/** a shared link to a node; the node is freed when the last tree version using it goes away */
+typedef shared_ptr<const PersistentTreeNode> PersistentNodePtr;
+
+/**
+ * A class representing an immutable node in a binary tree.
+ */
+class PersistentTreeNode {
+private:
+    /** the information stored in this node */
+    const string data;
+    /** treap priority: never lower than either child's */
+    const size_t priority;
+    /** a link to the left child node */
+    const PersistentNodePtr left;
+    /** a link to the right child node */
+    const PersistentNodePtr right;
+
+public:
+    /**
+     * constructor, the only place the contents of a node are set
+     * @param data the information to store
+     * @param priority the treap priority of data, from priorityOf
+     * @param left the left child (or nullptr)
+     * @param right the right child (or nullptr)
+     */
+    PersistentTreeNode(const string& data, size_t priority, PersistentNodePtr left, PersistentNodePtr right);
+
+    /**
+     * The treap priority for a piece of data:  a well mixed hash, so the priorities of any
+     * set of keys (sorted or not) look random and the tree stays balanced
+     * @param data the information to be stored
+     * @return the priority
+     */
+    static size_t priorityOf(const string& data);
+
+    /**
+     * Getter for data
+     * @return a reference to the data, valid as long as this node is
+     */
+    const string& getData() const;
+
+    /**
+     * Getter for priority
+     * @return the treap priority
+     */
+    size_t getPriority() const;
+
+    /**
+     * Getter for the left child
+     * @return a link to the left node, valid as long as this node is
+     */
+    const PersistentNodePtr& getLeft() const;
+
+    /**
+     * Getter for the right child
+     * @return a link to the right node, valid as long as this node is
+     */
+    const PersistentNodePtr& getRight() const;
+};
+#endif //PERSISTENTTREENODE_H
@@ -0,0 +1,268 @@
+/**
+ * @file ScopedTimer.cpp
+ * Nested, low overhead timers for profiling, with per-thread call trees and
+ * Chrome trace-event export.
+ * @date October 2026
+ */
+
+#include "ScopedTimer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef TIMER_USE_RDTSC
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // for __rdtsc
+#else
+#error "TIMER_USE_RDTSC needs an x86 processor -- build without it to use steady_clock."
+#endif
+#endif
+
+std::mutex TimerRegistry::registryLock;
+std::vector<std::unique_ptr<ThreadProfile> > TimerRegistry::profiles;
+std::vector<ThreadProfile*> TimerRegistry::freeProfiles;
+
+namespace {
+
+// the calling thread's profile; after the first timer on a thread this is all threadProfile reads
+thread_local ThreadProfile* threadLocalProfile = nullptr;
+
+// gives a thread's profile back to the registry when the thread exits
+struct ProfileReturner {
+    ~ProfileReturner() {
+        if (threadLocalProfile != nullptr) {
+            TimerRegistry::retireProfile(threadLocalProfile);
+            // a timer in a later thread_local destructor would start a fresh profile
+            threadLocalProfile = nullptr;
+        }
+    }
+};
+
+}
+
+#ifdef TIMER_USE_RDTSC
+
+// read the time stamp counter
+uint64_t ProfileClock::now() {
+    return __rdtsc();
+}
+
+// convert ticks to microseconds, measuring the counter's rate against steady_clock the first time
+double ProfileClock::ticksToMicroseconds(uint64_t ticks) {
+    // a function level static is initialized exactly once, even with several threads
+    static const double ticksPerMicrosecond = []() {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        uint64_t startTicks = __rdtsc();
+        // spin for about 10ms -- long enough to get a steady rate
+        while (std::chrono::steady_clock::now() - startTime < std::chrono::milliseconds(10)) {
+        }
+        uint64_t endTicks = __rdtsc();
+        double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+        return (endTicks - startTicks) / elapsed;
+    }();
+    return ticks / ticksPerMicrosecond;
+}
+
+#else
+
+// read steady_clock, in its native ticks
+uint64_t ProfileClock::now() {
+    return (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+// convert steady_clock ticks to microseconds
+double ProfileClock::ticksToMicroseconds(uint64_t ticks) {
+    return ticks * 1000000.0 * std::chrono::steady_clock::period::num / std::chrono::steady_clock::period::den;
+}
+
+#endif
+
+// start timing, as a child of whatever timer is already running on this thread
+ScopedTimer::ScopedTimer(const char* name) {
+    profile = TimerRegistry::threadProfile();
+
+    // look for this name among the current node's children -- usually only a handful
+    int parent = profile->current;
+    node = -1;
+    const std::vector<int>& children = profile->nodes[parent].children;
+    for (size_t i = 0; i < children.size(); i++) {
+        const char* childName = profile->nodes[children[i]].name;
+        if (childName == name || strcmp(childName, name) == 0) {
+            node = children[i];
+            break;
+        }
+    }
+    // first time this phase has run here -- add it to the call tree
+    if (node == -1) {
+        CallTreeNode newNode;
+        newNode.name = name;
+        newNode.parent = parent;
+        newNode.count = 0;
+        newNode.totalTicks = 0;
+        node = (int) profile->nodes.size();
+        profile->nodes.push_back(newNode);
+        profile->nodes[parent].children.push_back(node);
+    }
+    profile->current = node;
+
+    // read the clock last, so the bookkeeping above isn't counted
+    startTicks = ProfileClock::now();
+}
+
+// stop timing and record the result
+ScopedTimer::~ScopedTimer() {
+    // read the clock first, so the bookkeeping below isn't counted
+    uint64_t endTicks = ProfileClock::now();
+
+    CallTreeNode& thisNode = profile->nodes[node];
+    thisNode.count++;
+    thisNode.totalTicks += endTicks - startTicks;
+
+    if (profile->events.size() < TimerRegistry::MAX_EVENTS_PER_THREAD) {
+        TraceEvent event;
+        event.node = node;
+        event.startTicks = startTicks;
+        event.endTicks = endTicks;
+        profile->events.push_back(event);
+    } else {
+        profile->droppedEvents++;
+    }
+
+    profile->current = thisNode.parent;
+}
+
+// get the calling thread's profile, creating it the first time
+ThreadProfile* TimerRegistry::threadProfile() {
+    // after the first call on a thread this is just a read of a thread local pointer
+    ThreadProfile* profile = threadLocalProfile;
+    if (profile != nullptr) {
+        return profile;
+    }
+
+    // only touched here, so timing itself never pays for the thread_local destructor
+    static thread_local ProfileReturner returner;
+    (void) returner;
+
+    std::lock_guard<std::mutex> guard(registryLock);
+    if (!freeProfiles.empty()) {
+        // a thread has exited -- carry on with its profile (nothing is running in it)
+        profile = freeProfiles.back();
+        freeProfiles.pop_back();
+    } else {
+        // the registry owns the profile, so it outlives its thread and can still be reported
+        profile = new ThreadProfile();
+        CallTreeNode top;
+        top.name = "";
+        top.parent = -1;
+        top.count = 0;
+        top.totalTicks = 0;
+        profile->nodes.push_back(top);
+        profile->current = 0;
+        profile->droppedEvents = 0;
+        profile->threadNumber = (int) profiles.size() + 1;
+        profiles.push_back(std::unique_ptr<ThreadProfile>(profile));
+    }
+    threadLocalProfile = profile;
+    return profile;
+}
+
+// return an exiting thread's profile, so the next new thread can use it
+void TimerRegistry::retireProfile(ThreadProfile* profile) {
+    std::lock_guard<std::mutex> guard(registryLock);
+    freeProfiles.push_back(profile);
+}
+
+// report every thread's call tree
+std::string TimerRegistry::report() {
+    std::string outString = "";     // output string
+
+    std::lock_guard<std::mutex> guard(registryLock);
+    for (size_t i = 0; i < profiles.size(); i++) {
+        outString += "thread " + std::to_string(profiles[i]->threadNumber) + ":\n";
+        const std::vector<int>& children = profiles[i]->nodes[0].children;
+        for (size_t j = 0; j < children.size(); j++) {
+            reportNode(profiles[i].get(), children[j], 1, outString);
+        }
+        if (profiles[i]->droppedEvents > 0) {
+            outString += "  (" + std::to_string(profiles[i]->droppedEvents) + " trace events dropped)\n";
+        }
+    }
+    return outString;
+}
+
+// recursively add one call tree node and its children to the report
+void TimerRegistry::reportNode(const ThreadProfile* profile, int node, int depth, std::string& outString) {
+    const CallTreeNode& thisNode = profile->nodes[node];
+    double totalMicroseconds = ProfileClock::ticksToMicroseconds(thisNode.totalTicks);
+    char line[256];             // one formatted line of the report
+
+    snprintf(line, sizeof(line), "%*s%-*s %10llu calls %14.1f us total %12.3f us avg\n",
+             depth * 2, "", 32 - depth * 2 > 1 ? 32 - depth * 2 : 1, thisNode.name,
+             (unsigned long long) thisNode.count, totalMicroseconds,
+             thisNode.count == 0 ? 0.0 : totalMicroseconds / thisNode.count);
+    outString += line;
+
+    for (size_t i = 0; i < thisNode.children.size(); i++) {
+        reportNode(profile, thisNode.children[i], depth + 1, outString);
+    }
+}
+
+// write every recorded timer in Chrome trace-event JSON format
+void TimerRegistry::writeChromeTrace(std::ostream& out) {
+    std::lock_guard<std::mutex> guard(registryLock);
+
+    // times in the trace start from the earliest event, to keep the numbers small
+    uint64_t baseTicks = UINT64_MAX;
+    for (size_t i = 0; i < profiles.size(); i++) {
+        for (size_t j = 0; j < profiles[i]->events.size(); j++) {
+            if (profiles[i]->events[j].startTicks < baseTicks) {
+                baseTicks = profiles[i]->events[j].startTicks;
+            }
+        }
+    }
+
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    char times[64];             // formatted timestamp and duration
+    for (size_t i = 0; i < profiles.size(); i++) {
+        const ThreadProfile* profile = profiles[i].get();
+        for (size_t j = 0; j < profile->events.size(); j++) {
+            const TraceEvent& event = profile->events[j];
+
+            // names are usually plain identifiers, but escape anything that would break the JSON
+            std::string name = "";
+            for (const char* c = profile->nodes[event.node].name; *c != '\0'; c++) {
+                if (*c == '"' || *c == '\\') {
+                    name += '\\';
+                    name += *c;
+                } else if ((unsigned char) *c < 0x20) {
+                    name += ' ';
+                } else {
+                    name += *c;
+                }
+            }
+
+            // complete ("X") events: a start time and a duration, both in microseconds
+            snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f",
+                     ProfileClock::ticksToMicroseconds(event.startTicks - baseTicks),
+                     ProfileClock::ticksToMicroseconds(event.endTicks - event.startTicks));
+            out << (first ? "\n" : ",\n") << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << profile->threadNumber << "," << times << "}";
+            first = false;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+// forget everything recorded so far
+void TimerRegistry::reset() {
+    std::lock_guard<std::mutex> guard(registryLock);
+    // keep the profiles themselves, since their threads still hold pointers to them
+    for (size_t i = 0; i < profiles.size(); i++) {
+        profiles[i]->nodes.resize(1);
+        profiles[i]->nodes[0].children.clear();
+        profiles[i]->current = 0;
+        profiles[i]->events.clear();
+        profiles[i]->droppedEvents = 0;
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * @file ScopedTimer.h
+ * Nested, low overhead timers for profiling.  A ScopedTimer times the block it is declared
+ * in; timers declared inside other timers become children in a per-thread call tree
+ * (e.g. parse -> insert -> traverse).  Each thread only ever writes its own data, so timing
+ * takes no locks.  TimerRegistry reports the call trees and exports Chrome trace-event JSON
+ * (load it in chrome://tracing or Perfetto).
+ *
+ * The clock is chosen at compile time:  define TIMER_USE_RDTSC to read the x86 time stamp
+ * counter directly, otherwise std::chrono::steady_clock is used.
+ * @date October 2026
+ */
+
+#ifndef SCOPEDTIMER_H
+#define SCOPEDTIMER_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * The clock behind the scoped timers, in raw ticks.
+ */
+class ProfileClock {
+public:
+    /**
+     * Read the clock
+     * @return the current time in ticks
+     */
+    static uint64_t now();
+
+    /**
+     * Convert a number of ticks to microseconds
+     * @param ticks the number of ticks
+     * @return the same span of time in microseconds
+     */
+    static double ticksToMicroseconds(uint64_t ticks);
+};
+
+/**
+ * One node of a thread's call tree:  every entry into a timer with the same name and the
+ * same parent is added up here.
+ */
+struct CallTreeNode {
+    const char* name;           // the timer's name (must outlive the registry, e.g. a string literal)
+    int parent;                 // index of the parent node in the thread's call tree, -1 for the top
+    std::vector<int> children;  // indexes of the child nodes
+    uint64_t count;             // how many times this timer ran
+    uint64_t totalTicks;        // total time spent in this timer, including its children
+};
+
+/**
+ * One finished timer, kept for the trace export.
+ */
+struct TraceEvent {
+    int node;                   // the call tree node this event belongs to
+    uint64_t startTicks;        // when the timer started
+    uint64_t endTicks;          // when the timer stopped
+};
+
+/**
+ * Everything one thread has recorded.  Only that thread writes to it.  When the thread
+ * exits, the profile is handed on to the next thread that starts timing, which carries on
+ * adding to it.
+ */
+struct ThreadProfile {
+    int threadNumber;                   // small number to identify the profile in reports
+    std::vector<CallTreeNode> nodes;    // the call tree; node 0 is the (untimed) top
+    int current;                        // the node of the innermost running timer
+    std::vector<TraceEvent> events;     // finished timers, in the order they stopped
+    uint64_t droppedEvents;             // events not kept because the buffer was full
+};
+
+/**
+ * Times the enclosing block:  starts in the constructor, stops in the destructor.
+ */
+class ScopedTimer {
+private:
+    ThreadProfile* profile;     // the calling thread's profile
+    int node;                   // our node in the call tree
+    uint64_t startTicks;        // when we started
+
+public:
+    /**
+     * Start timing, as a child of whatever timer is already running on this thread.
+     * @param name the name of this phase (must outlive the registry, e.g. a string literal)
+     */
+    explicit ScopedTimer(const char* name);
+
+    /**
+     * Stop timing and record the result.
+     */
+    ~ScopedTimer();
+
+    // a timer belongs to exactly one block
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+/**
+ * Keeps track of every thread's profile, and reports on them.
+ * Reports read other threads' profiles without locking them, so only call report,
+ * writeChromeTrace or reset while no timers are running (e.g. after joining the workers).
+ */
+class TimerRegistry {
+private:
+    static std::mutex registryLock;                 // protects profiles and freeProfiles (taken once per thread)
+    static std::vector<std::unique_ptr<ThreadProfile> > profiles;  // one per thread that is, or was, timing at once
+    static std::vector<ThreadProfile*> freeProfiles;    // profiles of threads that have exited, ready for reuse
+
+public:
+    /**
+     * the most trace events kept per profile, so a long run can't use up all the memory.
+     * Profiles are reused once their thread exits, so at most (the most threads ever timing
+     * at the same time) x MAX_EVENTS_PER_THREAD events, 24 bytes each, are kept.
+     */
+    static const size_t MAX_EVENTS_PER_THREAD = 1000000;
+
+    /**
+     * Get the calling thread's profile, creating it the first time.
+     * @return the calling thread's profile
+     */
+    static ThreadProfile* threadProfile();
+
+    /**
+     * Return an exiting thread's profile, so the next new thread can use it
+     * @param profile the profile to give back
+     */
+    static void retireProfile(ThreadProfile* profile);
+
+    /**
+     * Report every thread's call tree, with counts, total and average times.  A thread
+     * that reused an exited thread's profile is reported together with it.
+     * @return a string containing the report
+     */
+    static std::string report();
+
+    /**
+     * Write every recorded timer in Chrome trace-event JSON format.
+     * @param out the stream to write to
+     */
+    static void writeChromeTrace(std::ostream& out);
+
+    /**
+     * Forget everything recorded so far.
+     */
+    static void reset();
+
+private:
+    /**
+     * recursively add one call tree node and its children to the report
+     * @param profile the thread the node belongs to
+     * @param node the node to report
+     * @param depth how far to indent
+     * @param outString the report so far
+     */
+    static void reportNode(const ThreadProfile* profile, int node, int depth, std::string& outString);
+};
+
+#endif //SCOPEDTIMER_H
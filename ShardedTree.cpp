@@ -0,0 +1,353 @@
+/**
+ * @file ShardedTree.cpp
+ * A container that spreads its keys across several independent Binary Search Trees
+ * (shards), partitioned by key hash or by sampled key ranges.
+ * @date October 2026
+ */
+
+#include "ShardedTree.h"
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <queue>
+using namespace std;
+
+// Constructor, initialize numShards empty trees
+ShardedTree::ShardedTree(int numShards, PartitionMode mode) throw(logic_error) {
+    if (numShards < 1) {
+        throw logic_error("Error -- a Sharded Tree needs at least one shard.");
+    }
+    this->numShards = numShards;
+    this->mode = mode;
+
+    // each shard is a completely independent tree with its own lock
+    shards = new BinarySearchTree*[numShards];
+    for (int i = 0; i < numShards; i++) {
+        shards[i] = new BinarySearchTree();
+    }
+    shardLocks = new mutex[numShards];
+
+    stopping = false;
+    for (int i = 1; i < numShards; i++) {
+        workers.push_back(thread(&ShardedTree::workerLoop, this));
+    }
+}
+
+// Destructor, free all of the shards
+ShardedTree::~ShardedTree() {
+    {
+        lock_guard<mutex> guard(jobLock);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+
+    for (int i = 0; i < numShards; i++) {
+        delete(shards[i]);
+        shards[i] = nullptr;
+    }
+    delete[] shards;
+    delete[] shardLocks;
+    shards = nullptr;
+    shardLocks = nullptr;
+}
+
+// Choose the range boundaries for RANGE_PARTITION from a sample of the keys
+void ShardedTree::setRangeBoundaries(vector<string> sample) throw(logic_error) {
+    if (mode != RANGE_PARTITION) {
+        throw logic_error("Error -- range boundaries only apply to a range partitioned Sharded Tree.");
+    }
+    // moving the boundaries would strand keys in the wrong shard
+    if (!isEmpty()) {
+        throw logic_error("Error -- cannot change range boundaries of a non-empty Sharded Tree.");
+    }
+
+    sort(sample.begin(), sample.end());
+    sample.erase(unique(sample.begin(), sample.end()), sample.end());
+
+    // pick numShards - 1 evenly spaced splitters; shard i holds keys below splitters[i]
+    splitters.clear();
+    if (sample.empty()) {
+        return;
+    }
+    for (int i = 1; i < numShards; i++) {
+        size_t position = (sample.size() * i) / numShards;
+        // a small sample can produce the same splitter twice -- that shard just stays empty
+        if (splitters.empty() || sample[position] > splitters.back()) {
+            splitters.push_back(sample[position]);
+        }
+    }
+}
+
+// Determine if every shard is empty.
+bool ShardedTree::isEmpty() const {
+    for (int i = 0; i < numShards; i++) {
+        lock_guard<mutex> guard(shardLocks[i]);
+        if (!shards[i]->isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Getter for the number of shards
+int ShardedTree::getNumShards() const {
+    return numShards;
+}
+
+// Insert a new item into the shard that owns it.
+void ShardedTree::insertNode(string newData) throw(logic_error) {
+    int shard = shardFor(newData);
+    lock_guard<mutex> guard(shardLocks[shard]);
+    shards[shard]->insertNode(newData);
+}
+
+// Insert a batch of items, working on every shard in parallel.
+void ShardedTree::insertBatch(const vector<string>& items) throw(logic_error) {
+    vector<vector<string> > buckets(numShards);     // the items that belong to each shard
+    vector<char> sawDuplicate(numShards, false);    // set by a worker that hit a duplicate (not vector<bool>, whose bits share words)
+    vector<int> shardList;                          // the shards with something to insert
+
+    // route every item to the shard that owns it
+    for (size_t i = 0; i < items.size(); i++) {
+        buckets[shardFor(items[i])].push_back(items[i]);
+    }
+    for (int shard = 0; shard < numShards; shard++) {
+        if (!buckets[shard].empty()) {
+            shardList.push_back(shard);
+        }
+    }
+
+    // each job owns exactly one shard, so the jobs never contend with each other
+    runOnShards(shardList, [this, &buckets, &sawDuplicate](int shard) {
+        lock_guard<mutex> guard(shardLocks[shard]);
+        for (size_t i = 0; i < buckets[shard].size(); i++) {
+            try {
+                shards[shard]->insertNode(std::move(buckets[shard][i]));
+            } catch (logic_error&) {
+                sawDuplicate[shard] = true;
+            }
+        }
+    });
+
+    // report duplicates the same way insertNode does, once the batch is finished
+    for (int shard = 0; shard < numShards; shard++) {
+        if (sawDuplicate[shard]) {
+            throw logic_error("Error -- cannot insert a duplicate node in a Binary Search Tree.");
+        }
+    }
+}
+
+// Remove and return the contents of a node from the shard that owns it.
+string ShardedTree::deleteNode(string key) {
+    int shard = shardFor(key);
+    lock_guard<mutex> guard(shardLocks[shard]);
+    return shards[shard]->deleteNode(key);
+}
+
+// Search for and return the contents of a node.
+string ShardedTree::fetchNode(string key) const {
+    int shard = shardFor(key);
+    lock_guard<mutex> guard(shardLocks[shard]);
+    return shards[shard]->fetchNode(key);
+}
+
+// Search for a batch of keys, working on every shard in parallel.
+vector<string> ShardedTree::fetchBatch(const vector<string>& keys) const {
+    vector<string> results(keys.size());            // answers, in the same order as keys
+    vector<vector<size_t> > buckets(numShards);     // the positions in keys that each shard answers
+    vector<int> shardList;                          // the shards with something to search for
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        buckets[shardFor(keys[i])].push_back(i);
+    }
+    for (int shard = 0; shard < numShards; shard++) {
+        if (!buckets[shard].empty()) {
+            shardList.push_back(shard);
+        }
+    }
+
+    // every job writes to its own positions in results, so no locking is needed there
+    runOnShards(shardList, [this, &keys, &buckets, &results](int shard) {
+        lock_guard<mutex> guard(shardLocks[shard]);
+        for (size_t i = 0; i < buckets[shard].size(); i++) {
+            size_t position = buckets[shard][i];
+            results[position] = shards[shard]->fetchNode(keys[position]);
+        }
+    });
+
+    return results;
+}
+
+// Search for the old contents, remove it, then add the new contents.
+void ShardedTree::updateNode(string oldContents, string newContents) {
+    // the two keys may live in different shards, so this is not atomic
+    deleteNode(oldContents);
+    insertNode(newContents);
+}
+
+// Conduct an inorder traversal across all of the shards, merging them into key order
+string ShardedTree::inorderTraversal() const {
+    string outString = "";              // output string
+    vector<vector<string> > perShard;   // each shard's contents, already sorted
+    size_t total = 0;                   // number of items across every shard
+
+    // collect and merge in one go, so a concurrent writer can't change the count under us
+    collectShards(perShard);
+    for (int i = 0; i < numShards; i++) {
+        total += perShard[i].size();
+    }
+    vector<string> sorted(total);
+    if (total > 0) {
+        mergeShards(perShard, &sorted[0]);
+    }
+
+    // format it the same way BinarySearchTree does
+    for (size_t i = 0; i < total; i++) {
+        outString += sorted[i] + "\t";
+    }
+
+    return outString;
+}
+
+// Count the number of nodes in all of the shards
+int ShardedTree::countNodes() const {
+    int numNodes = 0;      // number of nodes
+
+    for (int i = 0; i < numShards; i++) {
+        lock_guard<mutex> guard(shardLocks[i]);
+        numNodes += shards[i]->countNodes();
+    }
+
+    return numNodes;
+}
+
+// Fill the_array with every item, in sorted order, merging the shards.
+void ShardedTree::inorderTraversalFillArray(string the_array[], int size) const throw(logic_error) {
+    vector<vector<string> > perShard;   // each shard's contents, already sorted
+    int total = 0;                      // number of items across every shard
+
+    collectShards(perShard);
+    for (int i = 0; i < numShards; i++) {
+        total += perShard[i].size();
+    }
+    if (size != total) {
+        throw logic_error("Fatal error in Binary Search Tree sort.");
+    }
+
+    mergeShards(perShard, the_array);
+}
+
+// Merge the sorted contents of every shard into the_array
+void ShardedTree::mergeShards(const vector<vector<string> >& perShard, string the_array[]) const {
+    int next_index = 0;                 // next place to fill in the_array
+
+    if (mode == RANGE_PARTITION) {
+        // shards hold consecutive key ranges, so they are already in order end to end
+        for (int i = 0; i < numShards; i++) {
+            for (size_t j = 0; j < perShard[i].size(); j++) {
+                the_array[next_index] = perShard[i][j];
+                next_index++;
+            }
+        }
+        return;
+    }
+
+    // HASH_PARTITION: k-way merge, always taking the smallest front item of any shard
+    typedef pair<string, pair<int, size_t> > MergeEntry;   // (key, (shard, position in shard))
+    priority_queue<MergeEntry, vector<MergeEntry>, greater<MergeEntry> > fronts;
+    for (int i = 0; i < numShards; i++) {
+        if (!perShard[i].empty()) {
+            fronts.push(MergeEntry(perShard[i][0], make_pair(i, (size_t) 0)));
+        }
+    }
+    while (!fronts.empty()) {
+        MergeEntry smallest = fronts.top();
+        fronts.pop();
+        int shard = smallest.second.first;
+        size_t position = smallest.second.second;
+
+        the_array[next_index] = smallest.first;
+        next_index++;
+
+        if (position + 1 < perShard[shard].size()) {
+            fronts.push(MergeEntry(perShard[shard][position + 1], make_pair(shard, position + 1)));
+        }
+    }
+}
+
+// Figure out which shard owns a key
+int ShardedTree::shardFor(const string& key) const {
+    if (mode == HASH_PARTITION) {
+        return (int) (hash<string>()(key) % numShards);
+    }
+    // RANGE_PARTITION: the first splitter greater than the key marks its shard
+    return (int) (upper_bound(splitters.begin(), splitters.end(), key) - splitters.begin());
+}
+
+// Copy the contents of every shard out in sorted order, one vector per shard
+void ShardedTree::collectShards(vector<vector<string> >& perShard) const {
+    perShard.assign(numShards, vector<string>());
+    for (int i = 0; i < numShards; i++) {
+        lock_guard<mutex> guard(shardLocks[i]);
+        int size = shards[i]->countNodes();
+        perShard[i].resize(size);
+        if (size > 0) {
+            shards[i]->inorderTraversalFillArray(&perShard[i][0], size);
+        }
+    }
+}
+
+// Run work once for each listed shard, in parallel, and wait for all of them to finish
+void ShardedTree::runOnShards(const vector<int>& shardList, const function<void(int)>& work) const {
+    if (shardList.empty()) {
+        return;
+    }
+    mutex doneLock;                             // guards remaining
+    condition_variable allDone;                 // signalled when the last queued job finishes
+    size_t remaining = shardList.size() - 1;    // queued jobs not yet finished
+
+    // queue every shard but the last for the workers...
+    {
+        lock_guard<mutex> guard(jobLock);
+        for (size_t i = 0; i + 1 < shardList.size(); i++) {
+            int shard = shardList[i];
+            jobs.push_back([shard, &work, &doneLock, &allDone, &remaining]() {
+                work(shard);
+                // notify while holding the lock, so the waiter can't return (and destroy
+                // allDone) before notify_one does
+                lock_guard<mutex> doneGuard(doneLock);
+                remaining--;
+                if (remaining == 0) {
+                    allDone.notify_one();
+                }
+            });
+        }
+    }
+    jobReady.notify_all();
+
+    // ...and work on the last one here instead of sitting idle
+    work(shardList.back());
+
+    unique_lock<mutex> doneGuard(doneLock);
+    allDone.wait(doneGuard, [&remaining]() { return remaining == 0; });
+}
+
+// Batch worker thread:  run queued jobs until the tree is destroyed
+void ShardedTree::workerLoop() {
+    while (true) {
+        function<void()> job;       // the next job to run
+        {
+            unique_lock<mutex> guard(jobLock);
+            jobReady.wait(guard, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,182 @@
+/**
+ * @file ShardedTree.h
+ * A container that spreads its keys across several independent Binary Search Trees
+ * (shards), partitioned by key hash or by sampled key ranges.
+ * @date October 2026
+ */
+
+#ifndef SHARDEDTREE_H
+#define SHARDEDTREE_H
+
+#include "BinarySearchTree.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ShardedTree {
+
+public:
+    /**
+     * How keys are assigned to shards.
+     * HASH_PARTITION spreads keys evenly, but an in order traversal has to merge every shard.
+     * RANGE_PARTITION keeps each shard a contiguous key range, so shards are simply concatenated.
+     */
+    enum PartitionMode { HASH_PARTITION, RANGE_PARTITION };
+
+private:
+    int numShards;                      // number of independent trees
+    PartitionMode mode;                 // how keys are assigned to shards
+    BinarySearchTree** shards;          // the trees themselves, one per shard
+    mutex* shardLocks;                  // one lock per shard, so shards never wait on each other
+    vector<string> splitters;           // RANGE_PARTITION only: shard i holds keys < splitters[i]
+
+    // batch workers are started once and reused, so a small batch doesn't pay for thread start up
+    vector<thread> workers;                     // numShards - 1 workers; the caller works on one shard itself
+    mutable deque<function<void()> > jobs;      // per-shard batch jobs waiting for a worker
+    mutable mutex jobLock;                      // guards jobs and stopping
+    mutable condition_variable jobReady;        // signalled when a job is queued, or on shutdown
+    bool stopping;                              // set by the destructor to end the workers
+
+public:
+    /**
+     * Constructor, initialize numShards empty trees
+     * @param numShards the number of shards (at least 1)
+     * @param mode how keys are assigned to shards
+     * @throws logic_error if numShards is less than 1
+     */
+    ShardedTree(int numShards, PartitionMode mode = HASH_PARTITION) throw(logic_error);
+
+    /**
+     * Destructor, free all of the shards
+     */
+    ~ShardedTree();
+
+    // the tree owns its shards and locks, so copying it would free them twice
+    ShardedTree(const ShardedTree&) = delete;
+    ShardedTree& operator=(const ShardedTree&) = delete;
+
+    /**
+     * Choose the range boundaries for RANGE_PARTITION from a sample of the keys that will be
+     * inserted.  The sample is sorted and numShards - 1 evenly spaced keys become the splitters.
+     * Without a call to this method every key goes to the first shard.
+     * @param sample a representative sample of keys
+     * @throws logic_error if the tree is not empty, or the mode is not RANGE_PARTITION
+     */
+    void setRangeBoundaries(vector<string> sample) throw(logic_error);
+
+    /**
+     * Determine if every shard is empty.
+     * @return true if the tree is empty, false otherwise
+     */
+    bool isEmpty() const;
+
+    /**
+     * Getter for the number of shards
+     * @return the number of shards
+     */
+    int getNumShards() const;
+
+    /**
+     * Insert a new item into the shard that owns it.
+     * @param newData the information to insert
+     * @throws a logic_error if a duplicate node is inserted
+     */
+    void insertNode(string newData) throw(logic_error);
+
+    /**
+     * Insert a batch of items, working on every shard in parallel.  Every item that is not a
+     * duplicate is inserted, even if some of them are duplicates.
+     * @param items the items to insert
+     * @throws a logic_error (after the whole batch is processed) if any item was a duplicate
+     */
+    void insertBatch(const vector<string>& items) throw(logic_error);
+
+    /**
+     * Remove and return the contents of a node from the shard that owns it.
+     * @param key the identifying information for the node to delete
+     * @return the contents of a node, or the tree's not found message
+     */
+    string deleteNode(string key);
+
+    /**
+     * Search for and return the contents of a node.
+     * @param key the item to search for
+     * @return the contents of the node, or the tree's not found message
+     */
+    string fetchNode(string key) const;
+
+    /**
+     * Search for a batch of keys, working on every shard in parallel.
+     * @param keys the items to search for
+     * @return the result of fetchNode for each key, in the same order as keys
+     */
+    vector<string> fetchBatch(const vector<string>& keys) const;
+
+    /**
+     * Search for the old contents, remove it, then add the new contents.
+     * @param oldContents the item to remove
+     * @param newContents the item to add
+     */
+    void updateNode(string oldContents, string newContents);
+
+    /**
+     * Conduct an inorder traversal across all of the shards, merging them into key order
+     * @return a string containing the contents of the nodes
+     */
+    string inorderTraversal() const;
+
+    /**
+     * Count the number of nodes in all of the shards
+     * @return the total number of nodes
+     */
+    int countNodes() const;
+
+    /**
+     * Fill the_array with every item, in sorted order, merging the shards.
+     * @param the_array the array to place the Node contents into
+     * @param size the number of items in the array
+     * @throws logic_error if size does not match the number of nodes
+     */
+    void inorderTraversalFillArray(string the_array[], int size) const throw(logic_error);
+
+private:
+    /**
+     * Figure out which shard owns a key
+     * @param key the key to place
+     * @return the index of the owning shard
+     */
+    int shardFor(const string& key) const;
+
+    /**
+     * Run work once for each listed shard, in parallel on the batch workers and the calling
+     * thread, and wait for all of them to finish
+     * @param shardList the shards to work on
+     * @param work called with each shard number
+     */
+    void runOnShards(const vector<int>& shardList, const function<void(int)>& work) const;
+
+    /**
+     * Batch worker thread:  run queued jobs until the tree is destroyed
+     */
+    void workerLoop();
+
+    /**
+     * Copy the contents of every shard out in sorted order, one vector per shard
+     * @param perShard filled with numShards sorted vectors
+     */
+    void collectShards(vector<vector<string> >& perShard) const;
+
+    /**
+     * Merge the sorted contents of every shard into the_array
+     * @param perShard the sorted contents of each shard, from collectShards
+     * @param the_array the array to fill, large enough for every item
+     */
+    void mergeShards(const vector<vector<string> >& perShard, string the_array[]) const;
+};
+
+#endif //SHARDEDTREE_H
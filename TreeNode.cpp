@@ -6,22 +6,32 @@
  */
 
 #include "TreeNode.h"
+#include <utility>      // for move
 
 // default constructor
 TreeNode::TreeNode() {
     data = "";              // empty string
     left = nullptr;         // points to nothing
     right = nullptr;         // points to nothing
+    size = 1;               // just this node
+    height = 1;             // just this level
 }
 
 // getter for data
-string TreeNode::getData() const {
+const string& TreeNode::getData() const {
     return data;
 }
 
 // setter for data
-void TreeNode::setData(const string newData) {
-    data = newData;
+void TreeNode::setData(string newData) {
+    data = std::move(newData);
+}
+
+// move the data out, leaving an empty string behind
+string TreeNode::takeData() {
+    string oldData = std::move(data);
+    data = "";
+    return oldData;
 }
 
 // getter for left pointer
@@ -44,6 +54,27 @@ void TreeNode::setRight(TreeNode *newNext) {
     right = newNext;
 }
 
+// getter for subtree size
+int TreeNode::getSize() const {
+    return size;
+}
+
+// getter for subtree height
+int TreeNode::getHeight() const {
+    return height;
+}
+
+// recompute size and height from the (already up to date) children
+void TreeNode::updateShape() {
+    int leftSize = (left == nullptr) ? 0 : left->getSize();
+    int rightSize = (right == nullptr) ? 0 : right->getSize();
+    int leftHeight = (left == nullptr) ? 0 : left->getHeight();
+    int rightHeight = (right == nullptr) ? 0 : right->getHeight();
+
+    size = leftSize + rightSize + 1;
+    height = (leftHeight > rightHeight ? leftHeight : rightHeight) + 1;
+}
+
 // a string-based representation of this node
 string TreeNode::toString() {
     // print data
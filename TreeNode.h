@@ -22,6 +22,10 @@ private:
     TreeNode* left;
     /** a link to the right child node */
     TreeNode* right;
+    /** the number of nodes in the subtree rooted here, including this one */
+    int size;
+    /** the number of levels in the subtree rooted here (a leaf has height 1) */
+    int height;
 
 public:
     /**
@@ -31,15 +35,22 @@ public:
 
     /**
      * Getter for data
-     * @return a string representing the data
+     * @return a reference to the data, valid until the node changes or is deleted
      */
-    string getData() const;
+    const string& getData() const;
 
     /**
      * Setter for data
      * @param data the new data to include in the string
      */
-    void setData(const string data);
+    void setData(string data);
+
+    /**
+     * Move the data out of this node, leaving it empty.  Used when the tree is being
+     * taken apart, so the string doesn't have to be copied.
+     * @return the data that was in this node
+     */
+    string takeData();
 
     /**
      * Getter for the left child
@@ -65,6 +76,23 @@ public:
      */
     void setRight(TreeNode *next);
 
+    /**
+     * Getter for the subtree size
+     * @return the number of nodes in the subtree rooted here
+     */
+    int getSize() const;
+
+    /**
+     * Getter for the subtree height
+     * @return the number of levels in the subtree rooted here
+     */
+    int getHeight() const;
+
+    /**
+     * Recompute size and height from the children.  The children must already be up to date.
+     */
+    void updateShape();
+
     /**
      * A string-based representation of this node
      * @return a string that represents this node
@@ -0,0 +1,48 @@
+/**
+ * @file WordFiles.cpp
+ * Helpers for the benchmarks:  read the lists in word_files and scale them up.
+ * @date October 2026
+ */
+
+#include "WordFiles.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+// read every word from the files in word_files
+vector<string> readWords(const string& directory) {
+    const string FILE_NAMES[] = {"fivewords.txt", "tenwords.txt", "twentywords.txt", "fiftywords.txt",
+                                 "hundredwords.txt", "fourhundredwords.txt"};
+    vector<string> words;       // everything we read
+    string word;                // the word currently being read
+
+    for (const string& fileName : FILE_NAMES) {
+        ifstream inFile(directory + "/" + fileName);
+        if (!inFile) {
+            cerr << "Could not open " << directory << "/" << fileName << endl;
+            continue;
+        }
+        while (inFile >> word) {
+            words.push_back(word);
+        }
+    }
+
+    // the smaller files are subsets of the larger ones
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
+// scale the words up to numEntries unique, shuffled entries
+vector<string> makeEntries(const vector<string>& words, int numEntries, int firstCopy) {
+    vector<string> entries;     // word#copy, unique because the words are unique
+
+    entries.reserve(numEntries);
+    for (int i = 0; i < numEntries; i++) {
+        entries.push_back(words[i % words.size()] + "#" + to_string(firstCopy + i / words.size()));
+    }
+    // fixed seed, so every run uses the same input
+    shuffle(entries.begin(), entries.end(), mt19937(2017));
+    return entries;
+}
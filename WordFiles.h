@@ -0,0 +1,33 @@
+/**
+ * @file WordFiles.h
+ * Helpers for the benchmarks:  read the lists in word_files and scale them up to any
+ * number of unique entries.
+ * @date October 2026
+ */
+
+#ifndef WORDFILES_H
+#define WORDFILES_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Read every word from the files in word_files.
+ * @param directory where the word files live
+ * @return the distinct words, sorted
+ */
+vector<string> readWords(const string& directory);
+
+/**
+ * Scale the words up to numEntries unique entries ("word#n"), in a shuffled order so
+ * a tree is not built from sorted input.  Entries made with different firstCopy ranges
+ * never collide, so they can be used as known misses.
+ * @param words the distinct words to start from
+ * @param numEntries how many entries to make
+ * @param firstCopy the first n to use in "word#n"
+ * @return the entries
+ */
+vector<string> makeEntries(const vector<string>& words, int numEntries, int firstCopy = 0);
+
+#endif //WORDFILES_H
@@ -0,0 +1,89 @@
+/**
+ * @file filter_benchmark.cpp
+ * Measure fetchNode miss and hit latency with and without the membership filter, and the
+ * filter's false positive rate, at several sizes (bits per key).
+ *
+ * usage:  FilterBenchmark [numKeys] [numProbes] [wordDirectory]
+ *         (defaults: 1000000 keys, 1000000 probes, ./word_files)
+ * @date October 2026
+ */
+
+#include "BinarySearchTree.h"
+#include "Timer.h"
+#include "WordFiles.h"
+#include <cstdlib>
+#include <iostream>
+using namespace std;
+
+/**
+ * Time fetchNode over a list of keys
+ * @param tree the tree to search
+ * @param probes the keys to look up
+ * @return nanoseconds per lookup
+ */
+double timeLookups(const BinarySearchTree& tree, const vector<string>& probes) {
+    Timer timer;
+    size_t found = 0;           // keep the compiler from skipping the lookups
+
+    timer.startTimer();
+    for (size_t i = 0; i < probes.size(); i++) {
+        found += tree.fetchNode(probes[i]).size();
+    }
+    timer.stopTimer();
+
+    // found is always non-zero; the test just keeps it alive
+    return found == 0 ? 0.0 : timer.elapsedTime() * 1000.0 / probes.size();
+}
+
+int main(int argc, char* argv[]) {
+    int numKeys = argc > 1 ? atoi(argv[1]) : 1000000;
+    int numProbes = argc > 2 ? atoi(argv[2]) : 1000000;
+    string directory = argc > 3 ? argv[3] : "word_files";
+    if (numKeys < 1 || numProbes < 1) {
+        cerr << "usage:  FilterBenchmark [numKeys] [numProbes] [wordDirectory]" << endl;
+        return 1;
+    }
+
+    vector<string> words = readWords(directory);
+    if (words.empty()) {
+        cerr << "No words found -- run from the project directory, or pass the word directory." << endl;
+        return 1;
+    }
+
+    // the dictionary, plus candidate words that are known not to be in it
+    vector<string> keys = makeEntries(words, numKeys);
+    int firstMissCopy = (int) (numKeys / words.size()) + 1;
+    vector<string> misses = makeEntries(words, numProbes, firstMissCopy);
+    vector<string> hits(numProbes);
+    for (int i = 0; i < numProbes; i++) {
+        hits[i] = keys[(i * 7919L) % numKeys];
+    }
+
+    BinarySearchTree tree;
+    for (int i = 0; i < numKeys; i++) {
+        tree.insertNode(keys[i]);
+    }
+    cout << numKeys << " keys, " << numProbes << " probes, tree height " << tree.shapeReport().height << endl;
+    cout << "bits/key\tmiss ns\thit ns\tfalse positives\t(actual bits/key)" << endl;
+
+    cout << "none\t\t" << timeLookups(tree, misses) << "\t" << timeLookups(tree, hits) << "\t-" << endl;
+
+    const double BITS_PER_KEY[] = {4, 6, 8, 10, 12, 16};
+    for (double bitsPerKey : BITS_PER_KEY) {
+        tree.enableMembershipFilter(bitsPerKey);
+
+        // count how many misses the filter fails to reject
+        const BloomFilter* filter = tree.getMembershipFilter();
+        int falsePositives = 0;
+        for (int i = 0; i < numProbes; i++) {
+            if (filter->mayContain(misses[i])) {
+                falsePositives++;
+            }
+        }
+
+        cout << bitsPerKey << "\t\t" << timeLookups(tree, misses) << "\t" << timeLookups(tree, hits) << "\t"
+             << 100.0 * falsePositives / numProbes << "%\t\t(" << (double) filter->getNumBits() / numKeys << ")" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file layout_benchmark.cpp
+ * Measure lookup and traversal speed of a churned Binary Search Tree before and after
+ * BinarySearchTree::compact rewrites its nodes into one contiguous block.
+ *
+ * usage:  LayoutBenchmark [numKeys] [churnRounds] [numLookups]
+ *         (defaults: 10000000 keys, 3 rounds of churn, 2000000 lookups)
+ * @date October 2026
+ */
+
+#include "BinarySearchTree.h"
+#include "Timer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+
+/**
+ * Make a key that sorts in the same order as its number
+ * @param number the key number
+ * @return the key
+ */
+string makeKey(int number) {
+    string digits = to_string(number);
+    return "key" + string(10 - digits.size(), '0') + digits;
+}
+
+/**
+ * Time numLookups successful fetchNode calls and one full in order fill.
+ * @param label which tree this is
+ * @param tree the tree to measure
+ * @param liveKeys the keys currently in the tree
+ * @param numLookups how many lookups to time
+ */
+void measure(const string& label, BinarySearchTree& tree, const vector<string>& liveKeys, int numLookups) {
+    mt19937 random(7);          // same lookups for every measurement
+    Timer timer;
+    size_t found = 0;           // keep the compiler from skipping the lookups
+
+    vector<string> probes(numLookups);
+    for (int i = 0; i < numLookups; i++) {
+        probes[i] = liveKeys[random() % liveKeys.size()];
+    }
+
+    timer.startTimer();
+    for (int i = 0; i < numLookups; i++) {
+        found += tree.fetchNode(probes[i]).size();
+    }
+    timer.stopTimer();
+    double lookupTime = timer.elapsedTime();
+
+    vector<string> contents(tree.countNodes());
+    timer.startTimer();
+    tree.inorderTraversalFillArray(&contents[0], (int) contents.size());
+    timer.stopTimer();
+
+    cout << label << ":\tlookup " << lookupTime * 1000.0 / numLookups << " ns each"
+         << "\ttraversal " << timer.elapsedTime() / 1000.0 << " ms"
+         << "\t(" << found << " chars fetched)" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numKeys = argc > 1 ? atoi(argv[1]) : 10000000;
+    int churnRounds = argc > 2 ? atoi(argv[2]) : 3;
+    int numLookups = argc > 3 ? atoi(argv[3]) : 2000000;
+    if (numKeys < 2 || churnRounds < 0 || numLookups < 1) {
+        cerr << "usage:  LayoutBenchmark [numKeys] [churnRounds] [numLookups]" << endl;
+        return 1;
+    }
+
+    mt19937 random(2017);       // fixed seed, so every run builds the same tree
+    BinarySearchTree tree;
+    Timer timer;
+
+    // build from random keys, so the tree is reasonably shaped without rebalancing
+    vector<int> numbers;        // the key numbers currently in the tree
+    numbers.reserve(numKeys);
+    while ((int) numbers.size() < numKeys) {
+        int number = random() % 1000000000;
+        try {
+            tree.insertNode(makeKey(number));
+            numbers.push_back(number);
+        } catch (logic_error&) {
+            // already there -- pick another
+        }
+    }
+
+    // churn:  each round deletes half of the keys and inserts as many new random ones, so
+    // the surviving nodes end up scattered between allocations made at different times
+    for (int round = 0; round < churnRounds; round++) {
+        shuffle(numbers.begin(), numbers.end(), random);
+        for (int i = 0; i < numKeys / 2; i++) {
+            tree.deleteNode(makeKey(numbers[i]));
+            bool inserted = false;
+            while (!inserted) {
+                numbers[i] = random() % 1000000000;
+                try {
+                    tree.insertNode(makeKey(numbers[i]));
+                    inserted = true;
+                } catch (logic_error&) {
+                    // already there -- pick another
+                }
+            }
+        }
+    }
+    vector<string> liveKeys(numKeys);
+    for (int i = 0; i < numKeys; i++) {
+        liveKeys[i] = makeKey(numbers[i]);
+    }
+    cout << tree.countNodes() << " keys, " << churnRounds << " rounds of churn, height "
+         << tree.shapeReport().height << endl;
+
+    measure("before compact", tree, liveKeys, numLookups);
+
+    // breadth first first, then van Emde Boas (compacting a compacted tree is fine)
+    const BinarySearchTree::NodeLayout LAYOUTS[] = {BinarySearchTree::BREADTH_FIRST_LAYOUT,
+                                                     BinarySearchTree::VAN_EMDE_BOAS_LAYOUT};
+    const string NAMES[] = {"breadth first", "van Emde Boas"};
+    for (int i = 0; i < 2; i++) {
+        timer.startTimer();
+        tree.compact(LAYOUTS[i]);
+        timer.stopTimer();
+        cout << "compact (" << NAMES[i] << "):\t" << timer.elapsedTime() / 1000.0 << " ms" << endl;
+        measure("after compact (" + NAMES[i] + ")", tree, liveKeys, numLookups);
+    }
+
+    return 0;
+}
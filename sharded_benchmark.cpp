@@ -0,0 +1,143 @@
+/**
+ * @file sharded_benchmark.cpp
+ * Measure how ShardedTree throughput scales with the number of client threads on a mixed
+ * insert / fetch workload, with one shard (every thread shares one lock) against many,
+ * and how fast the batch calls are for small and large batches.
+ *
+ * usage:  ShardedBenchmark [numKeys] [maxThreads] [numShards]
+ *         (defaults: 2000000 keys, every hardware thread, 4 shards per hardware thread)
+ * @date October 2026
+ */
+
+#include "ShardedTree.h"
+#include "Timer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/**
+ * Make a key that sorts in the same order as its number
+ * @param number the key number
+ * @return the key
+ */
+string makeKey(int number) {
+    string digits = to_string(number);
+    return "key" + string(10 - digits.size(), '0') + digits;
+}
+
+/**
+ * Run the mixed workload:  the tree starts with the first half of keys, then numThreads
+ * client threads split the second half between them, and each inserts its keys one at a
+ * time with three fetches of already present keys after every insert.
+ * @param keys the keys, in random order
+ * @param numShards the number of shards to use
+ * @param numThreads the number of client threads
+ * @return operations (inserts plus fetches) per microsecond
+ */
+double mixedWorkload(const vector<string>& keys, int numShards, int numThreads) {
+    const int FETCHES_PER_INSERT = 3;
+    ShardedTree tree(numShards);
+    size_t half = keys.size() / 2;
+    Timer timer;
+
+    tree.insertBatch(vector<string>(keys.begin(), keys.begin() + half));
+
+    vector<thread> clients;     // the client threads
+    vector<size_t> found(numThreads, 0);    // keep the compiler from skipping the fetches
+    timer.startTimer();
+    for (int t = 0; t < numThreads; t++) {
+        clients.push_back(thread([&keys, &tree, &found, half, numThreads, t]() {
+            size_t first = half + (keys.size() - half) * t / numThreads;
+            size_t last = half + (keys.size() - half) * (t + 1) / numThreads;
+            mt19937 random(t);
+            for (size_t i = first; i < last; i++) {
+                tree.insertNode(keys[i]);
+                for (int j = 0; j < FETCHES_PER_INSERT; j++) {
+                    found[t] += tree.fetchNode(keys[random() % half]).size();
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < clients.size(); i++) {
+        clients[i].join();
+    }
+    timer.stopTimer();
+
+    return (keys.size() - half) * (1 + FETCHES_PER_INSERT) / timer.elapsedTime();
+}
+
+/**
+ * Time insertBatch and fetchBatch, split into batches of batchSize
+ * @param keys the keys, in random order
+ * @param numShards the number of shards to use
+ * @param batchSize the number of keys per batch
+ */
+void batchWorkload(const vector<string>& keys, int numShards, int batchSize) {
+    ShardedTree tree(numShards);
+    Timer timer;
+    size_t found = 0;           // keep the compiler from skipping the fetches
+
+    timer.startTimer();
+    for (size_t first = 0; first < keys.size(); first += batchSize) {
+        size_t last = min(keys.size(), first + batchSize);
+        tree.insertBatch(vector<string>(keys.begin() + first, keys.begin() + last));
+    }
+    timer.stopTimer();
+    double insertTime = timer.elapsedTime();
+
+    timer.startTimer();
+    for (size_t first = 0; first < keys.size(); first += batchSize) {
+        size_t last = min(keys.size(), first + batchSize);
+        vector<string> results = tree.fetchBatch(vector<string>(keys.begin() + first, keys.begin() + last));
+        found += results.size();
+    }
+    timer.stopTimer();
+
+    cout << numShards << "\t" << batchSize << "\t" << insertTime * 1000.0 / keys.size() << "\t\t"
+         << timer.elapsedTime() * 1000.0 / found << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int hardwareThreads = max(1, (int) thread::hardware_concurrency());
+    int numKeys = argc > 1 ? atoi(argv[1]) : 2000000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : hardwareThreads;
+    int numShards = argc > 3 ? atoi(argv[3]) : 4 * hardwareThreads;
+    if (numKeys < 2 || maxThreads < 1 || numShards < 1) {
+        cerr << "usage:  ShardedBenchmark [numKeys] [maxThreads] [numShards]" << endl;
+        return 1;
+    }
+
+    vector<string> keys(numKeys);
+    for (int i = 0; i < numKeys; i++) {
+        keys[i] = makeKey(i);
+    }
+    mt19937 random(2017);       // fixed seed, so every run uses the same order
+    shuffle(keys.begin(), keys.end(), random);
+    cout << numKeys << " keys, " << hardwareThreads << " hardware threads" << endl;
+
+    // mixed workload, scaling the client threads, with one shard and with numShards
+    cout << "threads\t1 shard ops/us\t" << numShards << " shards ops/us\tspeedup over 1 thread" << endl;
+    double baseline = 0.0;      // numShards shards, one thread
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        double oneShard = mixedWorkload(keys, 1, numThreads);
+        double manyShards = mixedWorkload(keys, numShards, numThreads);
+        if (numThreads == 1) {
+            baseline = manyShards;
+        }
+        cout << numThreads << "\t" << oneShard << "\t\t" << manyShards << "\t\t" << manyShards / baseline << endl;
+    }
+
+    // batch calls:  per key cost for small and large batches
+    cout << "shards\tbatch\tinsert ns/key\tfetch ns/key" << endl;
+    const int BATCH_SIZES[] = {64, 1024, 65536};
+    for (int batchSize : BATCH_SIZES) {
+        batchWorkload(keys, 1, batchSize);
+        batchWorkload(keys, numShards, batchSize);
+    }
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file sort_benchmark.cpp
+ * Compare Binary Search Tree sort against std::sort, a parallel std::sort and an MSD radix
+ * sort, using the words in word_files scaled up to a large number of unique entries.
+ *
+ * usage:  SortBenchmark [numEntries] [numThreads] [wordDirectory] [padding]
+ *         (defaults: 10000000 entries, every hardware thread, ./word_files, no padding)
+ * padding adds that many characters to the front of every entry.  The plain "word#n"
+ * entries fit in std::string's short string buffer, so moving them is no cheaper than
+ * copying; with 16 or more characters of padding every entry is heap allocated.
+ * @date October 2026
+ */
+
+#include "BinarySearchTree.h"
+#include "Timer.h"
+#include "WordFiles.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/**
+ * Sort with std::sort on numThreads threads:  sort equal chunks, then merge neighbouring
+ * chunks in parallel until one run is left.
+ * @param items the strings to sort
+ * @param numThreads the number of threads to use
+ */
+void parallelStdSort(vector<string>& items, int numThreads) {
+    vector<size_t> bounds;      // chunk i is items[bounds[i] .. bounds[i + 1])
+    vector<thread> workers;     // the threads for this round
+
+    for (int i = 0; i <= numThreads; i++) {
+        bounds.push_back(items.size() * i / numThreads);
+    }
+    for (int i = 0; i < numThreads; i++) {
+        workers.push_back(thread([&items, &bounds, i]() {
+            sort(items.begin() + bounds[i], items.begin() + bounds[i + 1]);
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+
+    // merge pairs of runs until there is only one
+    while (bounds.size() > 2) {
+        vector<size_t> merged;  // the run boundaries after this round
+        workers.clear();
+        for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+            if (i + 2 < bounds.size()) {
+                size_t first = bounds[i], middle = bounds[i + 1], last = bounds[i + 2];
+                workers.push_back(thread([&items, first, middle, last]() {
+                    inplace_merge(items.begin() + first, items.begin() + middle, items.begin() + last);
+                }));
+            }
+        }
+        merged.push_back(bounds.back());
+        for (size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+        bounds = merged;
+    }
+}
+
+/**
+ * MSD radix sort on one character position, recursing on each bucket.  Small buckets
+ * fall back to std::sort, which is faster there.
+ * @param items the whole array being sorted
+ * @param scratch a buffer the same size as items
+ * @param low the first index of this bucket
+ * @param high one past the last index of this bucket
+ * @param depth the character position to sort on (every string in the bucket agrees before it)
+ */
+void radixSort(vector<string>& items, vector<string>& scratch, size_t low, size_t high, size_t depth) {
+    const size_t CUTOFF = 32;       // below this, std::sort wins
+    const int BUCKETS = 257;        // one bucket for "string ended", then one per byte value
+    size_t counts[BUCKETS + 1] = {0};
+
+    if (high - low <= CUTOFF) {
+        sort(items.begin() + low, items.begin() + high);
+        return;
+    }
+
+    // count, then turn the counts into starting positions
+    for (size_t i = low; i < high; i++) {
+        int bucket = depth < items[i].size() ? (unsigned char) items[i][depth] + 1 : 0;
+        counts[bucket + 1]++;
+    }
+    for (int b = 0; b < BUCKETS; b++) {
+        counts[b + 1] += counts[b];
+    }
+
+    // distribute into scratch and back, moving rather than copying
+    size_t next[BUCKETS];
+    copy(counts, counts + BUCKETS, next);
+    for (size_t i = low; i < high; i++) {
+        int bucket = depth < items[i].size() ? (unsigned char) items[i][depth] + 1 : 0;
+        scratch[low + next[bucket]] = std::move(items[i]);
+        next[bucket]++;
+    }
+    for (size_t i = low; i < high; i++) {
+        items[i] = std::move(scratch[i]);
+    }
+
+    // bucket 0 holds strings that ended here, which are all equal; the rest need the next character
+    for (int b = 1; b < BUCKETS; b++) {
+        if (counts[b + 1] - counts[b] > 1) {
+            radixSort(items, scratch, low + counts[b], low + counts[b + 1], depth + 1);
+        }
+    }
+}
+
+/**
+ * Report one result and check that it really is sorted
+ * @param name what was measured
+ * @param microseconds how long it took
+ * @param result the sorted output
+ * @param expected the correctly sorted output
+ */
+void report(const string& name, double microseconds, const vector<string>& result, const vector<string>& expected) {
+    cout << name << ":\t" << microseconds / 1000.0 << " ms"
+         << (result == expected ? "" : "\t(WRONG ORDER)") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numEntries = argc > 1 ? atoi(argv[1]) : 10000000;
+    int numThreads = argc > 2 ? atoi(argv[2]) : (int) thread::hardware_concurrency();
+    string directory = argc > 3 ? argv[3] : "word_files";
+    int padding = argc > 4 ? atoi(argv[4]) : 0;
+    if (numEntries < 1 || padding < 0) {
+        cerr << "usage:  SortBenchmark [numEntries] [numThreads] [wordDirectory] [padding]" << endl;
+        return 1;
+    }
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+
+    vector<string> words = readWords(directory);
+    if (words.empty()) {
+        cerr << "No words found -- run from the project directory, or pass the word directory." << endl;
+        return 1;
+    }
+    vector<string> entries = makeEntries(words, numEntries);
+    // padding at the front, so comparisons still have to read it
+    for (size_t i = 0; i < entries.size(); i++) {
+        entries[i].insert(0, padding, '_');
+    }
+    cout << "Sorting " << entries.size() << " entries built from " << words.size() << " words, "
+         << padding << " characters of padding, " << numThreads << " threads" << endl;
+
+    // std::sort, also the reference answer for the others
+    vector<string> expected = entries;
+    Timer timer;
+    timer.startTimer();
+    sort(expected.begin(), expected.end());
+    timer.stopTimer();
+    report("std::sort", timer.elapsedTime(), expected, expected);
+
+    // parallel std::sort
+    vector<string> items = entries;
+    timer.startTimer();
+    parallelStdSort(items, numThreads);
+    timer.stopTimer();
+    report("parallel std::sort", timer.elapsedTime(), items, expected);
+
+    // radix sort
+    items = entries;
+    vector<string> scratch(items.size());
+    timer.startTimer();
+    radixSort(items, scratch, 0, items.size(), 0);
+    timer.stopTimer();
+    report("MSD radix sort", timer.elapsedTime(), items, expected);
+    scratch.clear();
+
+    // Binary Search Tree sort: building the tree, then the old copying fill, then the draining sorts.
+    // The draining sorts free every node as they go, so the fill is also timed together with
+    // freeing its tree -- that is the cost the drains should be compared with.
+    for (int mode = 0; mode < 3; mode++) {
+        BinarySearchTree* tree = new BinarySearchTree();
+        items = entries;
+        timer.startTimer();
+        for (size_t i = 0; i < items.size(); i++) {
+            tree->insertNode(std::move(items[i]));
+        }
+        timer.stopTimer();
+        double buildTime = timer.elapsedTime();
+
+        items.assign(entries.size(), "");
+        timer.startTimer();
+        if (mode == 0) {
+            tree->inorderTraversalFillArray(&items[0], (int) items.size());
+        } else if (mode == 1) {
+            tree->inorderTraversalDrainArray(&items[0], (int) items.size());
+        } else {
+            tree->parallelInorderTraversalDrainArray(&items[0], (int) items.size(), numThreads);
+        }
+        timer.stopTimer();
+        double sortTime = timer.elapsedTime();
+
+        timer.startTimer();
+        delete(tree);
+        timer.stopTimer();
+        double freeTime = timer.elapsedTime();
+
+        const string NAMES[] = {"tree fill (copy)", "tree drain (move)", "tree parallel drain"};
+        cout << "tree build:\t" << buildTime / 1000.0 << " ms" << endl;
+        report(NAMES[mode], sortTime, items, expected);
+        report(NAMES[mode] + " + free", sortTime + freeTime, items, expected);
+        report(NAMES[mode] + " + build + free", buildTime + sortTime + freeTime, items, expected);
+    }
+
+    return 0;
+}